@@ -43,6 +43,7 @@
 #include "ACU_RedBlackNode.hh"
 #include "ACU_Stack.hh"
 #include "ACU_Tree.hh"
+#include "ACU_FastIter.hh"
 
 ACU_Tree::ACU_Tree(const ArgVec<ACU_Pair>& source)
 {
@@ -85,6 +86,25 @@ ACU_Tree::makeTree(const ArgVec<ACU_Pair>& args,
   return t;
 }
 
+void
+ACU_Tree::insertMult(const ArgVec<ACU_Pair>& args, int factor)
+{
+  //
+  //	Insert each of a sorted list of arguments, with their multiplicities
+  //	multiplied by factor. Each insertion copies one path, so this is
+  //	only worth doing when args is short compared to the tree.
+  //
+  for (const ACU_Pair& p : args)
+    insertMult(p.dagNode, factor * p.multiplicity);
+}
+
+void
+ACU_Tree::insertMult(const ACU_Tree& other, int factor)
+{
+  for (ACU_FastIter i(other); i.valid(); i.next())
+    insertMult(i.getDagNode(), factor * i.getMultiplicity());
+}
+
 /*
 void
 ACU_Tree::copyToArgVec(ArgVec<ACU_Pair>& dest) const
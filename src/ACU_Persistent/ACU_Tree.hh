@@ -51,6 +51,8 @@ public:
   bool findGeqMult(int multiplicity, ACU_Stack& path) const;
 
   void insertMult(DagNode* dagNode, int multiplicity);
+  void insertMult(const ArgVec<ACU_Pair>& args, int factor);
+  void insertMult(const ACU_Tree& other, int factor);
   void deleteMult(ACU_Stack& path, int multiplicity);
   void deleteMult2(ACU_Stack& path, int multiplicity);
 
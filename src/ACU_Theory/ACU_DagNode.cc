@@ -65,7 +65,7 @@
 #include "ACU_MergeSort.cc"
 #include "ACU_DagOperations.cc"
 
-Vector<int> ACU_DagNode::runsBuffer(INITIAL_RUNS_BUFFER_SIZE);
+thread_local Vector<int> ACU_DagNode::runsBuffer(INITIAL_RUNS_BUFFER_SIZE);
 
 ACU_DagNode*
 getACU_DagNode(DagNode* dagNode)
@@ -367,6 +367,7 @@ ACU_DagNode::copyWithReplacement(Vector<RedexPosition>& redexStack,
 void
 ACU_DagNode::partialReplace(DagNode* replacement, ExtensionInfo* extensionInfo)
 {
+  MemoryCell::writeBarrier(this);
   ACU_ExtensionInfo* e = safeCast(ACU_ExtensionInfo*, extensionInfo);
   DagNode* unmatched = e->buildUnmatchedPortion();
   argArray.resizeWithoutPreservation(2);
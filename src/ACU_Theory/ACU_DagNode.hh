@@ -93,7 +93,8 @@ private:
     MERGE_THRESHOLD = 16,
 #endif
 
-    INITIAL_RUNS_BUFFER_SIZE = 4	// must be > 0
+    INITIAL_RUNS_BUFFER_SIZE = 4,	// must be > 0
+    INSERT_COST = 2	// cost of copying a tree node relative to copying a Pair
   };
   
   typedef ACU_Pair Pair;
@@ -126,6 +127,8 @@ private:
   void mergeSortAndUniquize();
 
   void collapse(DagNode* arg);
+  bool insertIntoTree();
+  static bool insertIsCheaper(int nrToInsert, int treeSize);
   void insertAlien(ACU_BaseDagNode* normalForm,
 		   int nMult,
 		   DagNode* alien,
@@ -145,9 +148,9 @@ private:
   //
   ArgVec<Pair> argArray;
   //
-  //	Pre-allocated buffer for run-time use.
+  //	Pre-allocated buffer for run-time use; one per thread.
   //
-  static Vector<int> runsBuffer;
+  static thread_local Vector<int> runsBuffer;
   //
   //	Most related classes need direct access to our argument list for efficiency.
   //
@@ -182,6 +185,19 @@ ACU_DagNode::ACU_DagNode(ACU_Symbol* symbol, int size, NormalizationStatus statu
   setNormalizationStatus(status);
 }
 
+inline bool
+ACU_DagNode::insertIsCheaper(int nrToInsert, int treeSize)
+{
+  //
+  //	Each persistent insertion copies a path of about log2(treeSize)
+  //	nodes while flattening the tree copies all of it.
+  //
+  int pathLength = 1;
+  for (int i = treeSize; i > 1; i >>= 1)
+    ++pathLength;
+  return nrToInsert * pathLength * INSERT_COST <= treeSize;
+}
+
 inline int
 ACU_DagNode::nrArgs() const
 {
@@ -54,6 +54,7 @@
 #include "localBinding.hh"
 #include "variableAbstractionSubproblem.hh"
 #include "equalitySubproblem.hh"
+#include "parallelMatcher.hh"
 
 //      variable class definitions
 #include "variableSymbol.hh"
@@ -25,6 +25,7 @@
 //
 #ifndef _ACU_LhsAutomaton_hh_
 #define _ACU_LhsAutomaton_hh_
+#include <mutex>
 #include "lhsAutomaton.hh"
 #include "ACU_Tree.hh"
 
@@ -117,6 +118,7 @@ protected:
   bool getCollapsePossible() const;
   Substitution& getLocal();
   Substitution& getLocal2();
+  std::recursive_mutex& getMatchLock();
   //
   //	Useful functionality for ACU_NonLinearAutomaton.
   //
@@ -180,6 +182,12 @@ private:
 				      ACU_ExtensionInfo* extensionInfo,
 				      int firstAlien,
 				      SubproblemAccumulator& subproblems);
+  int parallelAddEdges(ACU_DagNode* subject,
+		       Substitution& solution,
+		       int alienIndex,
+		       int first,
+		       ACU_Subproblem* subproblem,
+		       int patternNode);
   bool handleElementVariables(ACU_DagNode* subject,
 			      Substitution& solution,
 			      ACU_Subproblem* subproblem);
@@ -261,8 +269,10 @@ private:
   Vector<NonGroundAlien> groundedOutAliens;
   Vector<NonGroundAlien> nonGroundAliens;
   //
-  //	Data storage for match-time use
+  //	Data storage for match-time use; since an automaton belongs to a
+  //	module that may be used by several threads, match() holds matchLock.
   //
+  std::recursive_mutex matchLock;
   Substitution local;
   Substitution scratch;
   //
@@ -305,6 +315,12 @@ ACU_LhsAutomaton::getLocal2()
   return scratch;
 }
 
+inline std::recursive_mutex&
+ACU_LhsAutomaton::getMatchLock()
+{
+  return matchLock;
+}
+
 inline void
 ACU_LhsAutomaton::addUniqueCollapseAutomaton(LhsAutomaton* ucAutomaton)
 {
@@ -309,6 +309,7 @@ ACU_LhsAutomaton::match(DagNode* subject,
 			Subproblem*& returnedSubproblem,
 			ExtensionInfo* extensionInfo)
 {
+  std::lock_guard<std::recursive_mutex> guard(matchLock);
   if (subject->symbol() != topSymbol)
     {
       if (collapsePossible)
@@ -330,9 +331,18 @@ ACU_LhsAutomaton::match(DagNode* subject,
 			    returnedSubproblem,
 			    safeCast(ACU_ExtensionInfo*, extensionInfo));
 	  if (r == true || r == false)
-	    return r;
+	    {
+	      topSymbol->treeKept();
+	      return r;
+	    }
+	}
+      if (ParallelMatcher::onWorkerThread())
+	subject = ACU_TreeDagNode::copyToArgVec(t);  // t may be shared with other threads
+      else
+	{
+	  topSymbol->treeFlattened();
+	  (void) ACU_TreeDagNode::treeToArgVec(t);
 	}
-      (void) ACU_TreeDagNode::treeToArgVec(t);
     }
   ACU_DagNode* s = safeCast(ACU_DagNode*, subject);
   //
@@ -598,23 +608,28 @@ ACU_LhsAutomaton::buildBipartiteGraph(ACU_DagNode* subject,
       LhsAutomaton* a = nga.automaton;
       int m = nga.multiplicity;
       int pn = subproblem->addPatternNode(m);
-      for (int j = (t == 0) ? 0 : subject->findFirstPotentialMatch(t, solution);
-	   j < nrArgs; j++)
-        {
-	  DagNode* d = args[j].dagNode;
-	  if (t != 0 && t->partialCompare(solution, d) == Term::LESS)
-	    break;
-          if (currentMultiplicity[j] >= m)
-            {
-              local.copy(solution);
-              Subproblem* sp;
-              if (a->match(d, local, sp))
-                {
-                  subproblem->addEdge(pn, j, local - solution, sp);
-		  ++nrMatches;
-                }
-            }
-        }
+      int first = (t == 0) ? 0 : subject->findFirstPotentialMatch(t, solution);
+      if (ParallelMatcher::worthwhile(nrArgs - first))
+	nrMatches = parallelAddEdges(subject, solution, i, first, subproblem, pn);
+      else
+	{
+	  for (int j = first; j < nrArgs; j++)
+	    {
+	      DagNode* d = args[j].dagNode;
+	      if (t != 0 && t->partialCompare(solution, d) == Term::LESS)
+		break;
+	      if (currentMultiplicity[j] >= m)
+		{
+		  local.copy(solution);
+		  Subproblem* sp;
+		  if (a->match(d, local, sp))
+		    {
+		      subproblem->addEdge(pn, j, local - solution, sp);
+		      ++nrMatches;
+		    }
+		}
+	    }
+	}
       //cout << Tty(Tty::RED) << nrMatches << Tty(Tty::RESET) << ' ';
       if (nrMatches == 0)
         {
@@ -675,6 +690,49 @@ ACU_LhsAutomaton::buildBipartiteGraph(ACU_DagNode* subject,
   return subproblem;
 }
 
+int
+ACU_LhsAutomaton::parallelAddEdges(ACU_DagNode* subject,
+				   Substitution& solution,
+				   int alienIndex,
+				   int first,
+				   ACU_Subproblem* subproblem,
+				   int patternNode)
+{
+  //
+  //	Same as the sequential loop in buildBipartiteGraph() except that
+  //	the matching of nga against the potential subjects is shared
+  //	between several threads. Edges are added in subject order so
+  //	solutions are found in the same order.
+  //
+  ArgVec<ACU_DagNode::Pair>& args = subject->argArray;
+  int nrArgs = args.length();
+  NonGroundAlien& nga = nonGroundAliens[alienIndex];
+  Term* t = nga.term;
+  int m = nga.multiplicity;
+  Vector<DagNode*> subjects;
+  for (int j = first; j < nrArgs; j++)
+    {
+      DagNode* d = args[j].dagNode;
+      if (t != 0 && t->partialCompare(solution, d) == Term::LESS)
+	break;
+      subjects.append((currentMultiplicity[j] >= m) ? d : 0);
+    }
+  Vector<ParallelMatcher::Match> matches;
+  ParallelMatcher(nga.automaton, solution).matchSubjects(subjects, matches);
+  int nrMatches = 0;
+  int nrSubjects = subjects.size();
+  for (int j = 0; j < nrSubjects; j++)
+    {
+      const ParallelMatcher::Match& match = matches[j];
+      if (match.matched)
+	{
+	  subproblem->addEdge(patternNode, first + j, match.difference, match.subproblem);
+	  ++nrMatches;
+	}
+    }
+  return nrMatches;
+}
+
 bool
 ACU_LhsAutomaton::handleElementVariables(ACU_DagNode* subject,
 					 Substitution& solution,
@@ -84,6 +84,7 @@ ACU_NGA_LhsAutomaton::match(DagNode* subject,
 			    Subproblem*& returnedSubproblem,
 			    ExtensionInfo* extensionInfo)
 {
+  std::lock_guard<std::recursive_mutex> guard(getMatchLock());  // for getLocal()
   if (collectorFree(solution))
     {
       if (subject->symbol() == getSymbol())
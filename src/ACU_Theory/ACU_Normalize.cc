@@ -72,6 +72,78 @@ ACU_DagNode::collapse(DagNode* arg)
   remaining->overwriteWithClone(this);
 }
 
+bool
+ACU_DagNode::insertIntoTree()
+{
+  //
+  //	If one of our arguments is large compared to everything else,
+  //	insert the other arguments into a red-black tree version of it
+  //	rather than flattening everything into an argument array; this is
+  //	cheaper and keeps a growing argument list in tree form. An argument
+  //	array is converted in linear time, just as insertAlien() would do,
+  //	but only while our symbol's trees have tended to be kept.
+  //	We return true if we did this.
+  //
+  ACU_Symbol* s = symbol();
+  ACU_BaseDagNode* largest = 0;
+  int largestIndex = NONE;
+  int largestSize = 0;
+  int nrToInsert = 0;
+  int nrArgs = argArray.length();
+  for (int i = 0; i < nrArgs; i++)
+    {
+      DagNode* d = argArray[i].dagNode;
+      if (d->symbol() == s)
+	{
+	  ACU_BaseDagNode* b = safeCast(ACU_BaseDagNode*, d);
+	  int size = b->getSize();
+	  if (argArray[i].multiplicity == 1 && size > largestSize)
+	    {
+	      nrToInsert += largestSize;
+	      largest = b;
+	      largestIndex = i;
+	      largestSize = size;
+	    }
+	  else
+	    nrToInsert += size;
+	}
+      else
+	++nrToInsert;
+    }
+  if (largest == 0 || !insertIsCheaper(nrToInsert, largestSize))
+    return false;
+  if (largest->isTree())
+    s->treeKept();
+  else if (largestSize < CONVERT_THRESHOLD || !(s->speculateOnTree()))
+    return false;
+
+  Term* identity = s->getIdentity();
+  ACU_Tree t;
+  if (largest->isTree())
+    t = safeCast(ACU_TreeDagNode*, largest)->getTree();
+  else
+    t = ACU_Tree(safeCast(ACU_DagNode*, largest)->argArray);
+  for (int i = 0; i < nrArgs; i++)
+    {
+      if (i == largestIndex)
+	continue;
+      DagNode* d = argArray[i].dagNode;
+      int m = argArray[i].multiplicity;
+      if (d->symbol() == s)
+	{
+	  ACU_BaseDagNode* b = safeCast(ACU_BaseDagNode*, d);
+	  if (b->isTree())
+	    t.insertMult(safeCast(ACU_TreeDagNode*, b)->getTree(), m);
+	  else
+	    t.insertMult(safeCast(ACU_DagNode*, b)->argArray, m);
+	}
+      else if (identity == 0 || !(identity->equal(d)))
+	t.insertMult(d, m);
+    }
+  (void) new (this) ACU_TreeDagNode(s, t);
+  return true;
+}
+
 void
 ACU_DagNode::insertAlien(ACU_BaseDagNode* normalForm,
 			 int nMult,
@@ -83,6 +155,7 @@ ACU_DagNode::insertAlien(ACU_BaseDagNode* normalForm,
       ACU_Tree t = safeCast(ACU_TreeDagNode*, normalForm)->getTree();
       if (nMult == 1)
 	{
+	  symbol()->treeKept();
 	  t.insertMult(alien, aMult);
 	  (void) new (this) ACU_TreeDagNode(symbol(), t);
 	}
@@ -137,6 +210,7 @@ ACU_DagNode::normalizeAtTop()
 #if 0
   cout << "normalizeAtTop() " << this << endl;
 #endif
+  MemoryCell::writeBarrier(this);
   //
   //	We return true if we have an identity and collapsed out of theory or
   //	to something that was already in normal form.
@@ -283,6 +357,8 @@ ACU_DagNode::normalizeAtTop()
 	      //
 	      ACU_BaseDagNode* b0 = safeCast(ACU_BaseDagNode*, d0);
 	      ACU_BaseDagNode* b1 = safeCast(ACU_BaseDagNode*, d1);
+	      if (s->useTree() && insertIntoTree())
+		return false;
 	      if (argArray[0].multiplicity == 1 && argArray[1].multiplicity == 1)
 		{
 		  if (b0->isTree())
@@ -342,6 +418,8 @@ ACU_DagNode::normalizeAtTop()
   //
   //	General case.
   //
+  if (s->useTree() && insertIntoTree())
+    return false;
   return dumbNormalizeAtTop();
 }
 
@@ -353,6 +431,7 @@ ACU_DagNode::dumbNormalizeAtTop()
   //	Don't try any fancy optimizations and in particular never convert to
   //	tree form - thus we can safely be called during unification.
   //
+  MemoryCell::writeBarrier(this);
   ACU_Symbol* s = symbol();
   Term* identity = s->getIdentity();
   int expansion = 0;
@@ -55,6 +55,7 @@ ACU_Symbol::ACU_Symbol(int id,
   : AssociativeSymbol(id, strategy, memoFlag, identity)
 {
   useTreeFlag = useTree;
+  treeUseBalance = 0;
 }
 
 void 
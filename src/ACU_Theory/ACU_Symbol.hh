@@ -83,6 +83,14 @@ public:
   //	Member functions special to ACU_Symbol.
   //
   bool useTree() const;
+  //
+  //	Feedback on how red-black trees for this symbol get used, so that
+  //	argument arrays are only speculatively converted to trees while
+  //	trees tend to be kept rather than flattened back into arrays.
+  //
+  void treeKept();
+  void treeFlattened();
+  bool speculateOnTree();
 
 protected:
   //
@@ -105,7 +113,17 @@ private:
   bool complexStrategy(DagNode* subject, RewritingContext& context);
   bool memoStrategy(MemoTable::SourceSet& from, DagNode* subject, RewritingContext& context);
 
+  enum TreeUseBalance
+  {
+    WASTE_PENALTY = 64,	// charged for a speculative or flattened tree
+    BALANCE_LIMIT = 256	// bound on credit and debt
+  };
+
   bool useTreeFlag;
+  //
+  //	Only a heuristic; lost updates from racing threads don't matter.
+  //
+  int treeUseBalance;
 };
 
 inline bool
@@ -114,4 +132,35 @@ ACU_Symbol::useTree() const
   return useTreeFlag;
 }
 
+inline void
+ACU_Symbol::treeKept()
+{
+  if (treeUseBalance < BALANCE_LIMIT)
+    ++treeUseBalance;
+}
+
+inline void
+ACU_Symbol::treeFlattened()
+{
+  treeUseBalance -= WASTE_PENALTY;
+  if (treeUseBalance < -BALANCE_LIMIT)
+    treeUseBalance = -BALANCE_LIMIT;
+}
+
+inline bool
+ACU_Symbol::speculateOnTree()
+{
+  //
+  //	A speculative tree is paid for up front and has to be kept a
+  //	number of times before we speculate again.
+  //
+  if (treeUseBalance >= 0)
+    {
+      treeUseBalance -= WASTE_PENALTY;
+      return true;
+    }
+  ++treeUseBalance;  // so we try again eventually
+  return false;
+}
+
 #endif
@@ -225,6 +225,27 @@ ACU_TreeDagNode::treeToArgVec(ACU_TreeDagNode* original)
   return d;
 }
 
+ACU_DagNode*
+ACU_TreeDagNode::copyToArgVec(const ACU_TreeDagNode* original)
+{
+  //
+  //	Like treeToArgVec() but leaves original alone.
+  //
+  const ACU_Tree& t = original->tree;
+  ACU_DagNode* d = new ACU_DagNode(original->symbol(), t.getSize(), ASSIGNMENT);
+  ArgVec<ACU_DagNode::Pair>::iterator j = d->argArray.begin();
+  for (ACU_FastIter i(t); i.valid(); i.next(), ++j)
+    {
+      j->dagNode = i.getDagNode();
+      j->multiplicity = i.getMultiplicity();
+    }
+  Assert(j == d->argArray.end(), "iterators inconsistant");
+  d->setSortIndex(original->getSortIndex());
+  if (original->isReduced())
+    d->setReduced();
+  return d;
+}
+
 //
 //	Narrowing code.
 //
@@ -62,9 +62,12 @@ public:
   //
   bool indexVariables2(NarrowingVariableInfo& indices, int baseIndex);
   //
-  //	ACU_TreeDagNode -> ACU_DagNode in-place conversion function.
+  //	ACU_TreeDagNode -> ACU_DagNode in-place conversion function, and a
+  //	version that makes a new node for when original may be in use by
+  //	another thread.
   //
   static ACU_DagNode* treeToArgVec(ACU_TreeDagNode* original);
+  static ACU_DagNode* copyToArgVec(const ACU_TreeDagNode* original);
 
   const ACU_Tree& getTree() const;
 
@@ -556,8 +556,10 @@ ACU_UnificationSubproblem2::buildAndSolveDiophantineSystem(UnificationContext& s
   //	Extract the basis.
   //
   Vector<int> dioSol;
-  for (int index = 0; system.findNextMinimalSolution(dioSol);)
+  clock_t T0 = clock(); int NS = 0;
+  for (int index = 0; (system.findNextMinimalSolution(dioSol) || (cerr << "DIO " << nrDioVars << " vars " << NS << " sols " << (clock() - T0) / 1000 << "ms\n", false));)
     {
+      ++NS;
 #ifndef NO_ASSERT
       DebugAdvisory("added basis element for ACU_UnificationSubproblem2 " << ((void*) this));
       if (globalAdvisoryFlag)
@@ -219,6 +219,7 @@ AU_DagNode::copyWithReplacement(Vector<RedexPosition>& redexStack,
 void
 AU_DagNode::partialReplace(DagNode* replacement, ExtensionInfo* extensionInfo)
 {
+  MemoryCell::writeBarrier(this);
   AU_ExtensionInfo* e = safeCast(AU_ExtensionInfo*, extensionInfo);
   int first = e->firstMatched();
   int last = e->lastMatched();
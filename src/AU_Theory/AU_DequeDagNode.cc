@@ -191,6 +191,21 @@ AU_DequeDagNode::dequeToArgVec(AU_DequeDagNode* original)
   return d;
 }
 
+AU_DagNode*
+AU_DequeDagNode::copyToArgVec(const AU_DequeDagNode* original)
+{
+  //
+  //	Like dequeToArgVec() but leaves original alone, for when it may
+  //	be in use by another thread.
+  //
+  AU_DagNode* d = new AU_DagNode(original->symbol(), original->deque.length());
+  original->deque.copyToArgVec(d->argArray);
+  d->setSortIndex(original->getSortIndex());
+  if (original->isReduced())
+    d->setReduced();
+  return d;
+}
+
 //
 //	Narrowing code.
 //
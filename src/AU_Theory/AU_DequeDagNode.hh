@@ -64,6 +64,7 @@ public:
   int nrArgs() const;
   const AU_Deque& getDeque() const;
   static AU_DagNode* dequeToArgVec(AU_DequeDagNode* original);
+  static AU_DagNode* copyToArgVec(const AU_DequeDagNode* original);
 
 private:
   //
@@ -53,6 +53,7 @@
 #include "localBinding.hh"
 #include "variableAbstractionSubproblem.hh"
 #include "equalitySubproblem.hh"
+#include "parallelMatcher.hh"
 
 
 //	AU theory class definitions
@@ -25,6 +25,7 @@
 //
 #ifndef _AU_LhsAutomaton_hh_
 #define _AU_LhsAutomaton_hh_
+#include <mutex>
 #include "lhsAutomaton.hh"
 
 class AU_LhsAutomaton : public LhsAutomaton
@@ -287,7 +288,10 @@ private:
   Vector<Subterm> rigidPart;
   Vector<Subterm> flexPart;
   //
-  //	Data storage for match-time use.
+  //	Data storage for match-time use; since an automaton belongs to a
+  //	module that may be used by several threads, match() holds matchLock.
+  //
+  std::recursive_mutex matchLock;
   //
   //	Left and right limits of subject not matched by rigid part.
   //
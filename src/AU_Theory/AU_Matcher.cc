@@ -30,6 +30,7 @@ AU_LhsAutomaton::match(DagNode* subject,
 		       Subproblem*& returnedSubproblem,
 		       ExtensionInfo* extensionInfo)
 {
+  std::lock_guard<std::recursive_mutex> guard(matchLock);
   if (subject->symbol() != topSymbol)
     {
       if (collapsePossible)
@@ -48,7 +49,10 @@ AU_LhsAutomaton::match(DagNode* subject,
 	  if (r == true || r == false)
 	    return r;
 	}
-      (void) AU_DequeDagNode::dequeToArgVec(t);
+      if (ParallelMatcher::onWorkerThread())
+	subject = AU_DequeDagNode::copyToArgVec(t);  // t may be shared with other threads
+      else
+	(void) AU_DequeDagNode::dequeToArgVec(t);
     }
   
   AU_DagNode* s = safeCast(AU_DagNode*, subject);
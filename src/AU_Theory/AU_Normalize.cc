@@ -34,6 +34,7 @@ AU_DagNode::disappear(AU_Symbol* s, ArgVec<DagNode*>::const_iterator i)
 AU_DagNode::NormalizationResult
 AU_DagNode::normalizeAtTop(bool dumb)
 {
+  MemoryCell::writeBarrier(this);
   AU_Symbol* s = symbol();
   Term* identity = s->getIdentity();
   int expansion = 0;
@@ -152,6 +152,10 @@ ACU_NumberOpSymbol::eqRewrite2(DagNode* subject, RewritingContext& context)
 
   if (succSymbol != 0)
     {
+      bool result;
+      if (smallEqRewrite(subject, context, result))
+	return result;
+
       mpz_class accumulator;
       NatSet unused;
       int usedMultiplicity = 0;
@@ -273,3 +277,104 @@ ACU_NumberOpSymbol::eqRewrite2(DagNode* subject, RewritingContext& context)
     }
   return ACU_Symbol::eqRewrite(subject, context);
 }
+
+bool
+ACU_NumberOpSymbol::smallEqRewrite(DagNode* subject, RewritingContext& context, bool& result)
+{
+  //
+  //	Fast path for the common case where every argument is a number
+  //	that fits in a machine word. Returns false without doing anything
+  //	if there are other arguments, or the operation or an overflow
+  //	needs GMP.
+  //
+  switch (op)
+    {
+    case '+':
+    case '*':
+    case '|':
+    case '&':
+    case CODE('x', 'o'):
+    case CODE('m', 'i'):
+    case CODE('m', 'a'):
+      break;
+    default:
+      return false;
+    }
+  ACU_DagNode* d = getACU_DagNode(subject);
+  int nrArgs = d->nrArgs();
+  long accumulator = 0;
+  for (int i = 0; i < nrArgs; i++)
+    {
+      DagNode* a = d->getArgument(i);
+      Int64 n;
+      if (a->symbol() == minusSymbol)
+	{
+	  if (!(minusSymbol->isNeg(a) && minusSymbol->getSmallNeg(a, n)))
+	    return false;
+	}
+      else if (!(succSymbol->isNat(a) && succSymbol->getSmallNat(a, n)))
+	return false;
+      int m = d->getMultiplicity(i);
+      if (i == 0)
+	{
+	  accumulator = n;
+	  if (--m == 0)
+	    continue;
+	}
+      switch (op)
+	{
+	case '+':
+	  {
+	    long t;
+	    if (__builtin_mul_overflow(n, m, &t) ||
+		__builtin_add_overflow(accumulator, t, &accumulator))
+	      return false;
+	    break;
+	  }
+	case '*':
+	  {
+	    if (m > 63)
+	      return false;  // overflows unless n is -1, 0 or 1
+	    for (; m > 0; --m)
+	      {
+		if (__builtin_mul_overflow(accumulator, n, &accumulator))
+		  return false;
+	      }
+	    break;
+	  }
+	case '|':
+	  {
+	    accumulator |= n;
+	    break;
+	  }
+	case '&':
+	  {
+	    accumulator &= n;
+	    break;
+	  }
+	case CODE('x', 'o'):
+	  {
+	    if (m & 1)
+	      accumulator ^= n;
+	    break;
+	  }
+	case CODE('m', 'i'):
+	  {
+	    if (n < accumulator)
+	      accumulator = n;
+	    break;
+	  }
+	case CODE('m', 'a'):
+	  {
+	    if (n > accumulator)
+	      accumulator = n;
+	    break;
+	  }
+	}
+    }
+  Assert(minusSymbol != 0 || accumulator >= 0, "can't make -ve int");
+  result = (accumulator >= 0) ?
+    succSymbol->rewriteToNat(subject, context, static_cast<Int64>(accumulator)) :
+    context.builtInReplace(subject, minusSymbol->makeNegDag(accumulator));
+  return true;
+}
@@ -47,6 +47,7 @@ public:
 
 private:
   bool eqRewrite2(DagNode* subject, RewritingContext& context);
+  bool smallEqRewrite(DagNode* subject, RewritingContext& context, bool& result);
 
   int op;
   SuccSymbol* succSymbol;
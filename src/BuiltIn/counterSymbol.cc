@@ -119,8 +119,17 @@ CounterSymbol::ruleRewrite(DagNode* subject, RewritingContext& context)
 	  if (context.traceAbort())
 	    return 0;
 	}
-      DagNode* r = succSymbol->makeNatDag(currentValue);
-      ++currentValue;
+      //
+      //	We don't hold the lock while making the result since
+      //	allocation could wait for other threads to garbage collect.
+      //
+      mpz_class value;
+      {
+	std::lock_guard<std::mutex> lock(currentValueMutex);
+	value = currentValue;
+	++currentValue;
+      }
+      DagNode* r = succSymbol->makeNatDag(value);
       if (RewritingContext::getTraceStatus())
 	context.tracePostRuleRewrite(r);
       context.incrementRlCount();
@@ -27,6 +27,7 @@
 #define _counterSymbol_hh_
 #include <list>
 #include <stack>
+#include <mutex>
 #include "numberOpSymbol.hh"
 
 class CounterSymbol : public NumberOpSymbol
@@ -50,6 +51,7 @@ private:
   //typedef stack<mpz_class, list<mpz_class> > MpzStack;  // optimize for the empty case
 
   mpz_class currentValue;
+  std::mutex currentValueMutex;	// fair rewriting may be using us on several threads
   // MpzStack currentValueStack;
 };
 
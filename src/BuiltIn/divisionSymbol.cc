@@ -173,7 +173,7 @@ DivisionSymbol::isRat(const DagNode* dagNode) const
 }
 
 
-const mpz_class&
+mpz_class
 DivisionSymbol::getRat(const DagNode* dagNode, mpz_class& numerator) const
 {
   Assert(this == static_cast<const Symbol*>(dagNode->symbol()),
@@ -50,7 +50,7 @@ public:
   //
   DagNode* makeRatDag(const mpz_class& nr, const mpz_class& dr);
   bool isRat(const DagNode* dagNode) const;
-  const mpz_class& getRat(const DagNode* dagNode, mpz_class& numerator) const;
+  mpz_class getRat(const DagNode* dagNode, mpz_class& numerator) const;
   Term* makeRatTerm(const mpz_class& nr, const mpz_class& dr);
   bool isRat(/* const */ Term* term) const;
   const mpz_class& getRat(/* const */ Term* term, mpz_class& numerator) const;
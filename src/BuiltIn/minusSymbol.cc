@@ -113,6 +113,17 @@ MinusSymbol::getNeg(const DagNode* dagNode, mpz_class& result) const
   return result;
 }
 
+bool
+MinusSymbol::getSmallNeg(const DagNode* dagNode, Int64& value) const
+{
+  Assert(static_cast<const Symbol*>(dagNode->symbol()) == this,
+	 "symbol mismatch");
+  if (!(getSuccSymbol()->getSmallNat(safeCast(const FreeDagNode*, dagNode)->getArgument(0), value)))
+    return false;
+  value = -value;
+  return true;
+}
+
 DagNode*
 MinusSymbol::makeIntDag(const mpz_class& integer)
 {
@@ -44,6 +44,7 @@ public:
   DagNode* makeNegDag(const mpz_class& integer);
   bool isNeg(const DagNode* dagNode) const;
   const mpz_class& getNeg(const DagNode* dagNode, mpz_class& result) const;
+  bool getSmallNeg(const DagNode* dagNode, Int64& value) const;
   DagNode* makeIntDag(const mpz_class& integer);
   Term* makeIntTerm(const mpz_class& integer);
   bool isNeg(/* const */ Term* term) const;
@@ -191,6 +191,10 @@ NumberOpSymbol::eqRewrite(DagNode* subject, RewritingContext& context)
     }
   if (specialEval)
     {
+      bool result;
+      if (nrArgs < 3 && smallEqRewrite(d, context, result))
+	return result;
+
       mpz_class storage0;
       DagNode* d0 = d->getArgument(0);
       const mpz_class& a0 = (d0->symbol() == minusSymbol) ? 
@@ -447,6 +451,156 @@ NumberOpSymbol::eqRewrite(DagNode* subject, RewritingContext& context)
   return FreeSymbol::eqRewrite(subject, context);
 }
 
+bool
+NumberOpSymbol::getSmallNumber(DagNode* dagNode, Int64& value) const
+{
+  return (dagNode->symbol() == minusSymbol) ? minusSymbol->getSmallNeg(dagNode, value) :
+    succSymbol->getSmallNat(dagNode, value);
+}
+
+bool
+NumberOpSymbol::smallEqRewrite(FreeDagNode* subject, RewritingContext& context, bool& result)
+{
+  //
+  //	Fast path for when our arguments fit in a machine word, which they
+  //	nearly always do. Returns false without doing anything for cases
+  //	that need GMP, either because of the operation or overflow.
+  //	Numbers from getSmallNumber() lie in [-LONG_MAX, LONG_MAX] so
+  //	negation, abs, quo and rem cannot overflow.
+  //
+  Int64 a0;
+  Int64 a1 = 0;
+  bool binary = (arity() == 2);
+  if (!getSmallNumber(subject->getArgument(0), a0) ||
+      (binary && !getSmallNumber(subject->getArgument(1), a1)))
+    return false;
+
+  long r;
+  bool b;
+  if (!binary)
+    {
+      switch (op)
+	{
+	case '-':
+	  {
+	    if (a0 > 0)  // avoid infinite loop!
+	      goto fail;
+	    r = -a0;
+	    goto makeInt;
+	  }
+	case '~':
+	  {
+	    if (minusSymbol == 0)
+	      goto fail;
+	    r = ~a0;
+	    goto makeInt;
+	  }
+	case CODE('a', 'b'):
+	  {
+	    r = (a0 < 0) ? -a0 : a0;
+	    goto makeInt;
+	  }
+	}
+      return false;
+    }
+  switch (op)
+    {
+    case '+':
+      {
+	if (__builtin_add_overflow(a0, a1, &r))
+	  return false;
+	goto makeInt;
+      }
+    case '*':
+      {
+	if (__builtin_mul_overflow(a0, a1, &r))
+	  return false;
+	goto makeInt;
+      }
+    case '-':
+      {
+	if (minusSymbol == 0)
+	  goto fail;
+	if (__builtin_sub_overflow(a0, a1, &r))
+	  return false;
+	goto makeInt;
+      }
+    case '&':
+      {
+	r = a0 & a1;
+	goto makeInt;
+      }
+    case '|':
+      {
+	r = a0 | a1;
+	goto makeInt;
+      }
+    case CODE('x', 'o'):
+      {
+	r = a0 ^ a1;
+	goto makeInt;
+      }
+    case CODE('q', 'u'):
+      {
+	if (a1 == 0)
+	  goto fail;
+	r = a0 / a1;  // truncates like mpz_tdiv_q()
+	goto makeInt;
+      }
+    case CODE('r', 'e'):
+      {
+	if (a1 == 0)
+	  goto fail;
+	r = a0 % a1;  // sign of dividend like mpz_tdiv_r()
+	goto makeInt;
+      }
+    case '<':
+      {
+	b = a0 < a1;
+	goto makeBool;
+      }
+    case CODE('<', '='):
+      {
+	b = a0 <= a1;
+	goto makeBool;
+      }
+    case '>':
+      {
+	b = a0 > a1;
+	goto makeBool;
+      }
+    case CODE('>', '='):
+      {
+	b = a0 >= a1;
+	goto makeBool;
+      }
+    case CODE('d', 'i'):
+      {
+	if (a0 == 0)
+	  goto fail;
+	b = (a1 % a0 == 0);
+	goto makeBool;
+      }
+    }
+  return false;
+
+ makeInt:
+  Assert(minusSymbol != 0 || r >= 0, "can't make -ve int");
+  result = (r >= 0) ? succSymbol->rewriteToNat(subject, context, static_cast<Int64>(r)) :
+    context.builtInReplace(subject, minusSymbol->makeNegDag(r));
+  return true;
+
+ makeBool:
+  Assert(trueTerm.getTerm() != 0 && falseTerm.getTerm() != 0,
+	 "null true/false for relational op");
+  result = context.builtInReplace(subject, b ? trueTerm.getDag() : falseTerm.getDag());
+  return true;
+
+ fail:
+  result = FreeSymbol::eqRewrite(subject, context);
+  return true;
+}
+
 bool
 NumberOpSymbol::getNumber(DagNode* dagNode, mpz_class& value) const
 {
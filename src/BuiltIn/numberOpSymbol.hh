@@ -66,6 +66,9 @@ protected:
   bool getNumber(DagNode* dagNode, mpz_class& value) const;
 
 private:
+  bool getSmallNumber(DagNode* dagNode, Int64& value) const;
+  bool smallEqRewrite(FreeDagNode* subject, RewritingContext& context, bool& result);
+
   enum ImplementationConstants
   {
     EXPONENT_BOUND = 1000000	// max allowed exponent to limit runaway memory use
@@ -160,28 +160,49 @@ SuccSymbol::getNat(const Term* term) const
   return st->getNumber();
 }
 
-const mpz_class&
+mpz_class
 SuccSymbol::getNat(const DagNode* dagNode) const
 {
-  static mpz_class zero(0);
-
   const Symbol* s = dagNode->symbol();
   if (s != this)
     {
       Assert(zeroTerm.getTerm()->equal(dagNode), "not a nat");
-      return zero;
+      return 0;
     }
   const S_DagNode* sd = safeCast(const S_DagNode*, dagNode);
   Assert(zeroTerm.getTerm()->equal(sd->getArgument()), "arg not zero");
   return sd->getNumber();
 }
 
+bool
+SuccSymbol::getSmallNat(const DagNode* dagNode, Int64& value) const
+{
+  if (static_cast<const Symbol*>(dagNode->symbol()) != this)
+    {
+      value = 0;
+      return true;
+    }
+  const S_DagNode* sd = safeCast(const S_DagNode*, dagNode);
+  if (!(sd->isSmall()))
+    return false;
+  value = sd->getSmallNumber();
+  return true;
+}
+
 bool
 SuccSymbol::getSignedInt(const DagNode* dagNode, int& value) const
 {
   if (isNat(dagNode))
     {
-      const mpz_class& n = getNat(dagNode);
+      Int64 n64;
+      if (getSmallNat(dagNode, n64))
+	{
+	  if (n64 > INT_MAX)
+	    return false;
+	  value = n64;
+	  return true;
+	}
+      mpz_class n = getNat(dagNode);
       if (n.fits_sint_p())
 	{
 	  value = n.get_si();
@@ -196,7 +217,9 @@ SuccSymbol::getSignedInt64(const DagNode* dagNode, Int64& value) const
 {
   if (isNat(dagNode))
     {
-      const mpz_class& n = getNat(dagNode);
+      if (getSmallNat(dagNode, value))
+	return true;
+      mpz_class n = getNat(dagNode);
       mpz_class u = n >> BITS_PER_UINT;
       if (u.fits_sint_p())
 	{
@@ -253,3 +276,27 @@ SuccSymbol::rewriteToNat(DagNode* subject, RewritingContext& context, const mpz_
     context.tracePostEqRewrite(subject);
   return true;
 }
+
+bool
+SuccSymbol::rewriteToNat(DagNode* subject, RewritingContext& context, Int64 result)
+{
+  Assert(result >= 0, "-ve");
+  Assert(zeroTerm.getTerm() != 0, "zero not defined");
+
+  DagNode* zero = zeroTerm.getDag();
+  if (result == 0)
+    return context.builtInReplace(subject, zero);
+
+  bool trace = RewritingContext::getTraceStatus();
+  if (trace)
+    {
+      context.tracePreEqRewrite(subject, 0, RewritingContext::BUILTIN);
+      if (context.traceAbort())
+	return false;
+    }
+  (void) new(subject) S_DagNode(this, result, zero);
+  context.incrementEqCount();
+  if (trace)
+    context.tracePostEqRewrite(subject);
+  return true;
+}
@@ -63,10 +63,16 @@ public:
   bool isNat(const Term* term) const;
   bool isNat(const DagNode* dagNode) const;
   const mpz_class& getNat(const Term* term) const;
-  const mpz_class& getNat(const DagNode* dagNode) const;
+  mpz_class getNat(const DagNode* dagNode) const;
   bool getSignedInt(const DagNode* dagNode, int& value) const;
   bool getSignedInt64(const DagNode* dagNode, Int64& value) const;
   bool rewriteToNat(DagNode* subject, RewritingContext& context, const mpz_class& result);
+  bool rewriteToNat(DagNode* subject, RewritingContext& context, Int64 result);
+  //
+  //	Fast access for a dagNode already known to be a Nat; fails if
+  //	the number is too large to be held without GMP.
+  //
+  bool getSmallNat(const DagNode* dagNode, Int64& value) const;
   //
   //	In case the number won't fill in an Int64 but a scaled version will
   //	so we do the scaling before converting. Scaling always rounds down.
@@ -25,6 +25,7 @@
 //
 #ifndef _CUI_LhsAutomaton_hh_
 #define _CUI_LhsAutomaton_hh_
+#include <mutex>
 #include "lhsAutomaton.hh"
 
 class CUI_LhsAutomaton : public LhsAutomaton
@@ -124,8 +125,10 @@ private:
   Subpattern subpattern0;
   Subpattern subpattern1;
   //
-  //	Data storage for match-time use
+  //	Data storage for match-time use; since an automaton belongs to a
+  //	module that may be used by several threads, match() holds matchLock.
   //
+  std::recursive_mutex matchLock;
   Substitution local;
 
   friend ostream& operator<<(ostream& s, PatternType type);
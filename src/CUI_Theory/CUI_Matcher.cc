@@ -30,6 +30,7 @@ CUI_LhsAutomaton::match(DagNode* subject,
 			Subproblem*& returnedSubproblem,
 			ExtensionInfo* extensionInfo)
 {
+  std::lock_guard<std::recursive_mutex> guard(matchLock);
   DisjunctiveSubproblemAccumulator alternatives(solution);
   Flags f = flags;
   bool greedyMatchOK = f & GREEDY_MATCH_OK;
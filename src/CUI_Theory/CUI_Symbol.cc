@@ -170,6 +170,7 @@ CUI_Symbol::eqRewrite(DagNode* subject, RewritingContext& context)
               --a;  // real arguments start at 0 not 1
               if (seenZero)
                 {
+                  MemoryCell::writeBarrier(subject);
                   args[a] = args[a]->copyReducible();
                   //
                   //    A previous call to applyReplace() may have
@@ -230,6 +231,7 @@ CUI_Symbol::memoStrategy(MemoTable::SourceSet& from,
 	  --a;  // real arguments start at 0 not 1
 	  if (seenZero)
 	    {
+	      MemoryCell::writeBarrier(subject);
 	      args[a] = args[a]->copyReducible();
 	      //
 	      //    A previous call to applyReplace() may have
@@ -228,7 +228,7 @@ ArgVec<T>::evacuate()
   size_type l = len;
   allocatedBytes = l * sizeof(T);
   pointer v = basePtr;
-  basePtr = static_cast<pointer>(MemoryCell::allocateStorage(allocatedBytes));
+  basePtr = static_cast<pointer>(MemoryCell::allocateEvacuationStorage(allocatedBytes));
   for (pointer n = basePtr; l != 0; l--)
     *n++ = *v++;
 }
@@ -24,6 +24,8 @@
 //      Implementation for class CachedDag.
 //
 
+#include <mutex>
+
 //	utility stuff
 #include "macros.hh"
 #include "vector.hh"
@@ -50,3 +52,21 @@ CachedDag::prepare()
   Vector<int> emptyVector;
   term->markEagerArguments(0, emptySet, emptyVector);
 }
+
+DagNode*
+CachedDag::makeDag()
+{
+  //
+  //	Several threads may be rewriting with the same module, so we only
+  //	allow one of them to make the cached dag.
+  //
+  static std::mutex makeDagMutex;
+  std::lock_guard<std::mutex> guard(makeDagMutex);
+  DagNode* d = dag.getNode();
+  if (d == 0)
+    {
+      d = term->term2Dag(term->getSortIndex() != Sort::SORT_UNKNOWN);  // HACK
+      dag.setNode(d);
+    }
+  return d;
+}
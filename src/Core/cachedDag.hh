@@ -48,6 +48,8 @@ public:
   Instruction* getInstructionSequence() const;
 
 private:
+  DagNode* makeDag();
+
   Term* term;
   DagRoot dag;
   Instruction* instructionSequence;
@@ -93,12 +95,7 @@ inline DagNode*
 CachedDag::getDag()
 {
   DagNode* d = dag.getNode();
-  if (d == 0)
-    {
-      d = term->term2Dag(term->getSortIndex() != Sort::SORT_UNKNOWN);  // HACK
-      dag.setNode(d);
-    }
-  return d;
+  return (d == 0) ? makeDag() : d;
 }
 
 inline DagRoot*
@@ -29,6 +29,7 @@
 class MemoryBlock;
 class MemoryInfo;
 class MemoryCell;
+class ParallelMarker;
 class NamedEntity;
 class ModuleItem;
 class LineNumber;
@@ -59,6 +60,8 @@ class SortConstraintTable;
 class EquationTable;
 class RuleTable;
 class RewritingContext;
+class ParallelFairTraversal;
+class ParallelMatcher;
 class SubproblemAccumulator;
 class DisjunctiveSubproblemAccumulator;
 class RedexPosition;
@@ -94,5 +97,6 @@ class StackMachine;
 class StackMachineRhsCompiler;
 class ReturnInstruction;
 class NullInstruction;
+class SortInfoCache;
 
 #endif
@@ -162,7 +162,7 @@ SortTable::minimizeWrtCtor(NatSet& alive, int argNr) const
     }
 }
 
-void
+bool
 SortTable::buildCtorDiagram()
 {
   //
@@ -181,7 +181,7 @@ SortTable::buildCtorDiagram()
       WarningCheck(unique, "constructor declarations for constant " <<
 		   QUOTE(safeCastNonNull<Symbol*>(this)) <<
 		   " are inconsistant.");
-      return;
+      return unique;
     }
 
   Vector<NatSet> nextStates;
@@ -232,5 +232,9 @@ SortTable::buildCtorDiagram()
       currentBase = nextBase;
     }
   if (!(badTerminals.empty()))
-    sortErrorAnalysis(false, badTerminals);
+    {
+      sortErrorAnalysis(false, badTerminals);
+      return false;
+    }
+  return true;
 }
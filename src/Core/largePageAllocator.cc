@@ -0,0 +1,163 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//      Implementation for class LargePageAllocator.
+//
+#include <mutex>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+//	utility stuff
+#include "macros.hh"
+
+//	core class definitions
+#include "largePageAllocator.hh"
+
+#ifdef __linux__
+//
+//	We call mbind() directly rather than depend on libnuma.
+//
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE	3
+#endif
+#ifndef MPOL_LOCAL
+#define MPOL_LOCAL	4
+#endif
+#endif
+
+LargePageAllocator::PageMode LargePageAllocator::pageMode = NORMAL_PAGES;
+LargePageAllocator::NumaPolicy LargePageAllocator::numaPolicy = DEFAULT_NUMA;
+char* LargePageAllocator::nextFree = 0;
+size_t LargePageAllocator::bytesFree = 0;
+size_t LargePageAllocator::bytesReserved = 0;
+static std::mutex regionMutex;	// threads allocate arenas and buckets concurrently
+
+void*
+LargePageAllocator::allocate(size_t nrBytes)
+{
+  std::lock_guard<std::mutex> lock(regionMutex);
+  nrBytes = (nrBytes + ALIGNMENT - 1) & ~static_cast<size_t>(ALIGNMENT - 1);
+  if (nrBytes > bytesFree)
+    {
+      if (nrBytes > REGION_SIZE / 4)
+	{
+	  //
+	  //	Big requests get a region of their own so we don't waste
+	  //	the rest of the current region.
+	  //
+	  size_t regionSize = (nrBytes + HUGE_PAGE_SIZE - 1) &
+	    ~static_cast<size_t>(HUGE_PAGE_SIZE - 1);
+	  return newRegion(regionSize);
+	}
+      nextFree = newRegion(REGION_SIZE);
+      bytesFree = REGION_SIZE;
+    }
+  void* t = nextFree;
+  nextFree += nrBytes;
+  bytesFree -= nrBytes;
+  return t;
+}
+
+char*
+LargePageAllocator::newRegion(size_t nrBytes)
+{
+  void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  if (pageMode == EXPLICIT_HUGE_PAGES)
+    {
+      p = mmap(0, nrBytes, PROT_READ | PROT_WRITE,
+	       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (p == MAP_FAILED)
+	{
+	  IssueAdvisory("unable to map explicit huge pages (" << strerror(errno) <<
+			"); using transparent huge pages instead.");
+	  pageMode = TRANSPARENT_HUGE_PAGES;
+	}
+    }
+#endif
+  if (p == MAP_FAILED)
+    {
+      //
+      //	Over-allocate so we can trim the region to a huge page boundary;
+      //	the kernel can only back aligned 2 MB extents with huge pages.
+      //
+      size_t mappedSize = nrBytes + HUGE_PAGE_SIZE;
+      void* m = mmap(0, mappedSize, PROT_READ | PROT_WRITE,
+		     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (m == MAP_FAILED)
+	{
+	  cerr << "mmap() failed: " << strerror(errno) << endl;
+	  exit(1);
+	}
+      char* start = static_cast<char*>(m);
+      char* aligned = reinterpret_cast<char*>
+	((reinterpret_cast<size_t>(start) + HUGE_PAGE_SIZE - 1) &
+	 ~static_cast<size_t>(HUGE_PAGE_SIZE - 1));
+      if (aligned > start)
+	munmap(start, aligned - start);
+      char* end = aligned + nrBytes;
+      char* mappedEnd = start + mappedSize;
+      if (mappedEnd > end)
+	munmap(end, mappedEnd - end);
+      p = aligned;
+#ifdef MADV_HUGEPAGE
+      if (pageMode == TRANSPARENT_HUGE_PAGES)
+	(void) madvise(p, nrBytes, MADV_HUGEPAGE);
+#endif
+    }
+  applyNumaPolicy(p, nrBytes);
+  bytesReserved += nrBytes;
+  return static_cast<char*>(p);
+}
+
+void
+LargePageAllocator::applyNumaPolicy(void* region, size_t nrBytes)
+{
+  if (numaPolicy == DEFAULT_NUMA)
+    return;
+#if defined(__linux__) && defined(SYS_mbind)
+  //
+  //	An all-ones mask is intersected by the kernel with the nodes we are
+  //	allowed to use; MPOL_LOCAL needs an empty mask.
+  //
+  unsigned long nodeMask = ~0UL;
+  int mode = (numaPolicy == INTERLEAVE_NUMA) ? MPOL_INTERLEAVE : MPOL_LOCAL;
+  long r = (mode == MPOL_LOCAL) ?
+    syscall(SYS_mbind, region, nrBytes, mode, 0, 0, 0) :
+    syscall(SYS_mbind, region, nrBytes, mode, &nodeMask, 8 * sizeof(nodeMask), 0);
+  if (r != 0)
+    {
+      IssueAdvisory("unable to set NUMA policy (" << strerror(errno) <<
+		    "); using default placement.");
+      numaPolicy = DEFAULT_NUMA;
+    }
+#else
+  IssueAdvisory("NUMA placement is not supported on this platform.");
+  numaPolicy = DEFAULT_NUMA;
+#endif
+}
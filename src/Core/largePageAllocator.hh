@@ -0,0 +1,101 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	Class for carving the garbage collector's arenas and buckets out of
+//	large mmap()'d regions, backed by huge pages and with a NUMA placement
+//	policy if requested, to reduce TLB misses on large heaps.
+//
+//	Arenas and buckets are never freed, so neither is anything we hand out.
+//
+#ifndef _largePageAllocator_hh_
+#define _largePageAllocator_hh_
+
+class LargePageAllocator
+{
+public:
+  enum PageMode
+  {
+    NORMAL_PAGES,
+    TRANSPARENT_HUGE_PAGES,	// 2 MB aligned regions with MADV_HUGEPAGE hint
+    EXPLICIT_HUGE_PAGES		// MAP_HUGETLB; fall back to transparent if none reserved
+  };
+
+  enum NumaPolicy
+  {
+    DEFAULT_NUMA,
+    INTERLEAVE_NUMA,		// spread pages round-robin across nodes
+    LOCAL_NUMA			// keep pages on the node that touches them first
+  };
+
+  static void setPageMode(PageMode mode);
+  static void setNumaPolicy(NumaPolicy policy);
+  //
+  //	If neither option was chosen we leave allocation to operator new.
+  //
+  static bool inUse();
+  static void* allocate(size_t nrBytes);
+  static size_t getNrBytesReserved();
+
+private:
+  enum Sizes
+  {
+    HUGE_PAGE_SIZE = 2 * 1024 * 1024,
+    REGION_SIZE = 32 * HUGE_PAGE_SIZE,
+    ALIGNMENT = 16
+  };
+
+  static char* newRegion(size_t nrBytes);
+  static void applyNumaPolicy(void* region, size_t nrBytes);
+
+  static PageMode pageMode;
+  static NumaPolicy numaPolicy;
+  static char* nextFree;
+  static size_t bytesFree;
+  static size_t bytesReserved;
+};
+
+inline void
+LargePageAllocator::setPageMode(PageMode mode)
+{
+  pageMode = mode;
+}
+
+inline void
+LargePageAllocator::setNumaPolicy(NumaPolicy policy)
+{
+  numaPolicy = policy;
+}
+
+inline bool
+LargePageAllocator::inUse()
+{
+  return pageMode != NORMAL_PAGES || numaPolicy != DEFAULT_NUMA;
+}
+
+inline size_t
+LargePageAllocator::getNrBytesReserved()
+{
+  return bytesReserved;
+}
+
+#endif
@@ -24,6 +24,7 @@
 //      Implementation for class MemoTable.
 //
 #include <map>
+#include <mutex>
 
 //	utility stuff
 #include "macros.hh"
@@ -42,6 +43,11 @@
 #include "memoMap.hh"
 #include "memoTable.hh"
 
+//
+//	Memo maps are shared by all threads rewriting in a module.
+//
+static std::mutex memoMutex;
+
 bool
 MemoTable::memoRewrite(SourceSet& sourceSet, DagNode* subject, RewritingContext& context)
 {
@@ -50,10 +56,15 @@ MemoTable::memoRewrite(SourceSet& sourceSet, DagNode* subject, RewritingContext&
 		" at " << ((void*) subject) <<
 		" has sort index " << subject->getSortIndex());
 #endif
-  MemoMap* memoMap = getModule()->getMemoMap();
-  int subjectIndex = memoMap->getFromIndex(subject);
-
-  if (DagNode* toDag = memoMap->getToDag(subjectIndex))
+  int subjectIndex;
+  DagNode* toDag;
+  {
+    std::lock_guard<std::mutex> lock(memoMutex);
+    MemoMap* memoMap = getModule()->getMemoMap();
+    subjectIndex = memoMap->getFromIndex(subject);
+    toDag = memoMap->getToDag(subjectIndex);
+  }
+  if (toDag != 0)
     {
 #if 0
       DebugAdvisory("memoRewrite()  toDag " << subject << 
@@ -85,6 +96,7 @@ MemoTable::memoEnter(SourceSet& sourceSet, DagNode* destination)
 		" at " << ((void*) destination) <<
 		" has sort index " << destination->getSortIndex());
 #endif
+  std::lock_guard<std::mutex> lock(memoMutex);
   MemoMap* memoMap = getModule()->getMemoMap();
   for (int index : sourceSet)
     memoMap->assignToDag(index, destination);
@@ -24,6 +24,10 @@
 //      Implementation for base class MemoryCell
 //
 
+#include <cmath>
+#include <mutex>
+#include <condition_variable>
+
 //	utility stuff
 #include "macros.hh"
 #include "vector.hh"
@@ -35,8 +39,11 @@
 #include "symbol.hh"
 #include "dagNode.hh"
 #include "rootContainer.hh"
+#include "rewritingContext.hh"
 
 #include "memoryCell.hh"
+#include "parallelMarker.hh"
+#include "largePageAllocator.hh"
 
 struct MemoryCell::Arena
 {
@@ -57,37 +64,152 @@ MemoryCell::Arena::firstNode()
 
 bool MemoryCell::showGC = false;
 //
-//	Arena management variables.
+//	Heap sizing variables.
+//
+size_t MemoryCell::initialHeapSize = 0;
+double MemoryCell::growthFactor = DEFAULT_GROWTH;
+size_t MemoryCell::maxHeapSize = 0;
+bool MemoryCell::heapLimitFlag = false;
+//
+//	Generational mode variables.
+//
+bool MemoryCell::generational = false;
+int MemoryCell::sweepMask = MARKED;
+Vector<DagNode*> MemoryCell::rememberedSet;
+int MemoryCell::majorThreshold = 0;
+Int64 MemoryCell::nrMinorCollections = 0;
+Int64 MemoryCell::nrMajorCollections = 0;
+//
+//	Parallel marking variables.
+//
+int MemoryCell::nrGcThreads = 1;
+thread_local Vector<DagNode*>* MemoryCell::markStack = 0;
+thread_local char* MemoryCell::evacuationChunk = 0;
+thread_local size_t MemoryCell::evacuationBytesFree = 0;
+static std::mutex storageMutex;	// protects bucket storage during parallel marking
+//
+//	Per thread heap variables. The list of heaps and the safepoint
+//	state are protected by heapMutex.
 //
-int MemoryCell::nrArenas = 0;
-int nrNodesInUse = 0;  // FIX ME
-bool MemoryCell::currentArenaPastActiveArena = true;
-bool MemoryCell::needToCollectGarbage = false;
-MemoryCell::Arena* MemoryCell::firstArena = 0;
-MemoryCell::Arena* MemoryCell::lastArena = 0;
-MemoryCell::Arena* MemoryCell::currentArena = 0;
-MemoryCell* MemoryCell::nextNode = 0;
-MemoryCell* MemoryCell::endPointer = 0;
-MemoryCell::Arena* MemoryCell::lastActiveArena = 0;
-MemoryCell* MemoryCell::lastActiveNode = 0;
+thread_local MemoryCell::Heap MemoryCell::heap;
+Vector<MemoryCell::Heap*> MemoryCell::heaps;
+MemoryCell::Heap* MemoryCell::collectorHeap = 0;
+int MemoryCell::nrLiveNodes = 0;
+thread_local int nrNodesInUse = 0;  // FIX ME
+static std::mutex heapMutex;
+static std::condition_variable safepoint;
+static int nrAttachedThreads = 0;
+static int nrWaitingThreads = 0;	// attached threads waiting at a safepoint
+static bool collectionInProgress = false;
+static Int64 nrCollections = 0;
+static std::mutex rememberedSetMutex;
+
 //
-//	Bucket management variables.
+//	A thread that allocated is detached when it exits so that its heap
+//	can be adopted by another thread.
 //
-int MemoryCell::nrBuckets = 0;
-MemoryCell::Bucket* MemoryCell::bucketList = 0;
-MemoryCell::Bucket* MemoryCell::unusedList = 0;
-size_t MemoryCell::bucketStorage = 0;
-size_t MemoryCell::storageInUse = 0;
-size_t MemoryCell::target = INITIAL_TARGET;
+struct ThreadExitHook
+{
+  ~ThreadExitHook();
+};
+
+ThreadExitHook::~ThreadExitHook()
+{
+  MemoryCell::detachThread();
+}
+
+static thread_local ThreadExitHook threadExitHook;
+
+void
+MemoryCell::Heap::copy(const Heap& other)
+{
+  attached = other.attached;
+  needToCollectGarbage.store(other.needToCollectGarbage.load(std::memory_order_relaxed),
+			     std::memory_order_relaxed);
+  nrArenas = other.nrArenas;
+  currentArenaPastActiveArena = other.currentArenaPastActiveArena;
+  firstArena = other.firstArena;
+  lastArena = other.lastArena;
+  currentArena = other.currentArena;
+  nextNode = other.nextNode;
+  endPointer = other.endPointer;
+  lastActiveArena = other.lastActiveArena;
+  lastActiveNode = other.lastActiveNode;
+  nrBuckets = other.nrBuckets;
+  bucketList = other.bucketList;
+  unusedList = other.unusedList;
+  bucketStorage = other.bucketStorage;
+  storageInUse = other.storageInUse;
+  target = other.target;
+}
+
+void
+MemoryCell::attachThread()
+{
+  std::unique_lock<std::mutex> lock(heapMutex);
+  if (heap.attached)
+    return;
+  //
+  //	We can't touch the list of heaps during a collection.
+  //
+  safepoint.wait(lock, []{ return !collectionInProgress; });
+  (void) &threadExitHook;  // make sure we detach on exit
+  heap.attached = true;
+  ++nrAttachedThreads;
+  //
+  //	Adopt a heap abandoned by a thread that detached if there is one;
+  //	otherwise start a new one.
+  //
+  for (Heap*& h : heaps)
+    {
+      if (!(h->attached))
+	{
+	  Heap* abandoned = h;
+	  heap.copy(*abandoned);
+	  heap.attached = true;
+	  h = &heap;
+	  delete abandoned;
+	  return;
+	}
+    }
+  size_t initialTarget = initialHeapSize / 2;  // half of initial heap is for bucket storage
+  if (heap.target < initialTarget)
+    heap.target = initialTarget;
+  heaps.append(&heap);
+}
+
+void
+MemoryCell::detachThread()
+{
+  std::unique_lock<std::mutex> lock(heapMutex);
+  if (!heap.attached)
+    return;
+  //
+  //	Our heap lives in thread local storage, so we move it to an
+  //	abandoned heap which stays on the list.
+  //
+  Heap* abandoned = new Heap;
+  abandoned->copy(heap);
+  abandoned->attached = false;
+  for (Heap*& h : heaps)
+    {
+      if (h == &heap)
+	h = abandoned;
+    }
+  heap.copy(Heap());
+  --nrAttachedThreads;
+  safepoint.notify_all();  // a collecting thread may be waiting for us
+}
 
 MemoryCell::Arena*
-MemoryCell::allocateNewArena()
+MemoryCell::Heap::allocateNewArena()
 {
 #ifdef GC_DEBUG
   cerr << "allocateNewArena()\n";
   dumpMemoryVariables(cerr);
 #endif
-  Arena* a = new Arena;
+  Arena* a = LargePageAllocator::inUse() ?
+    new(LargePageAllocator::allocate(sizeof(Arena))) Arena : new Arena;
   a->nextArena = 0;
   if (lastArena == 0)
     firstArena = a;
@@ -102,12 +224,22 @@ MemoryCell::allocateNewArena()
 }
 
 MemoryCell*
-MemoryCell::slowNew()
+MemoryCell::Heap::slowNew()
 {
 #ifdef GC_DEBUG
   cerr << "slowNew()\n";
   dumpMemoryVariables(cerr);
 #endif
+  if (!attached)
+    {
+      //
+      //	First allocation by this thread; if we adopt an abandoned heap
+      //	we continue its lazy sweep.
+      //
+      MemoryCell::attachThread();
+      if (MemoryCell* d = lazySweep())
+	return d;
+    }
   for(;;)
     {
       if (currentArena == 0)
@@ -116,15 +248,23 @@ MemoryCell::slowNew()
 	  //	Allocate first arena.
 	  //
 	  currentArena = allocateNewArena();
+	  //
+	  //	Half of the initial heap is for nodes, so allocate
+	  //	those arenas up front.
+	  //
+	  int nrInitialArenas = initialHeapSize / (2 * sizeof(Arena));
+	  while (nrArenas < nrInitialArenas)
+	    (void) allocateNewArena();
 	  MemoryCell* d = currentArena->firstNode();
-	  endPointer = d + ARENA_SIZE - RESERVE_SIZE;
+	  endPointer = d +
+	    ((firstArena->nextArena != 0) ? ARENA_SIZE : ARENA_SIZE - RESERVE_SIZE);
 	  //Assert(d->h.flags == 0, "flags not cleared");
 	  return d;
 	}
       Arena* a = currentArena->nextArena;
       if (a == 0)
 	{
-	  needToCollectGarbage = true;
+	  needToCollectGarbage.store(true, std::memory_order_relaxed);
 	 MemoryCell* e = currentArena->firstNode() + ARENA_SIZE;
 	  if (endPointer != e)
 	    {
@@ -160,32 +300,49 @@ MemoryCell::slowNew()
 	  endPointer = nextNode +
 	    ((a->nextArena != 0) ? ARENA_SIZE : ARENA_SIZE - RESERVE_SIZE);
 	}
-      //
-      //	Now execute lazy sweep to actually find a free location
-      //
+      if (MemoryCell* d = lazySweep())
+	return d;
+    }
+}
+
+MemoryCell*
+MemoryCell::Heap::lazySweep()
+{
+  //
+  //	Execute lazy sweep to actually find a free location.
+  //
 #ifdef GC_DEBUG
-      checkInvariant();
+  checkInvariant();
 #endif
-      MemoryCell* e = endPointer;
-      for (MemoryCell* d = nextNode; d != e; d++)
+  MemoryCell* e = endPointer;
+  for (MemoryCell* d = nextNode; d != e; d++)
+    {
+      if (d->simpleReuse())
 	{
-	  if (d->simpleReuse())
-	    {
-	      return d;
-	    }
-	  if (!(d->isMarked()))
-	    {
-	      d->callDtor();
-	      return d;
-	    }
-	  d->clearFlag(MARKED);
+	  return d;
+	}
+      if (!(d->isMarked()))
+	{
+	  d->callDtor();
+	  return d;
 	}
+      d->clearFlag(sweepMask);
     }
+  return 0;
 }
 
 void*
-MemoryCell::slowAllocateStorage(size_t bytesNeeded)
+MemoryCell::Heap::slowAllocateStorage(size_t bytesNeeded)
 {
+  if (!attached)
+    {
+      //
+      //	First allocation by this thread.
+      //
+      storageInUse -= bytesNeeded;
+      MemoryCell::attachThread();
+      return allocateStorage(bytesNeeded);
+    }
   Bucket* p = 0;
   for (Bucket* b = unusedList; b; p = b, b = b->nextBucket)
     {
@@ -216,7 +373,9 @@ MemoryCell::slowAllocateStorage(size_t bytesNeeded)
   if (size < MIN_BUCKET_SIZE)
     size = MIN_BUCKET_SIZE;
 
-  Bucket* b = static_cast<Bucket*>(operator new[](size));
+  Bucket* b = static_cast<Bucket*>(LargePageAllocator::inUse() ?
+				    LargePageAllocator::allocate(size) :
+				    operator new[](size));
   ++nrBuckets;
   void* t = b + 1;
   size_t nrBytes = size - sizeof(Bucket);
@@ -230,12 +389,35 @@ MemoryCell::slowAllocateStorage(size_t bytesNeeded)
 }
 
 void
-MemoryCell::tidyArenas()
+MemoryCell::Heap::freeAllBuckets()
+{
+  //
+  //	Only called on heaps other than that of the collecting thread,
+  //	which receives all the live bucket storage.
+  //
+  while (Bucket* b = bucketList)
+    {
+      bucketList = b->nextBucket;
+      b->nextBucket = unusedList;
+      unusedList = b;
+    }
+  for (Bucket* b = unusedList; b; b = b->nextBucket)
+    {
+      b->bytesFree = b->nrBytes;
+      b->nextFree = b + 1;  // reset
+    }
+  storageInUse = 0;
+}
+
+void
+MemoryCell::Heap::tidyArenas()
 {
 #ifdef GC_DEBUG
   cerr << "tidyArenas()\n";
   dumpMemoryVariables(cerr);
 #endif
+  if (currentArena == 0)
+    return;  // nothing allocated
   //
   //	Tidy up lazy sweep phase - clear marked flags and call dtors
   //	where necessary.
@@ -293,36 +475,321 @@ MemoryCell::tidyArenas()
   lastActiveNode = newLastActiveNode;
 }
 
+void
+MemoryCell::setGenerational(bool polarity)
+{
+  Assert(heaps.empty(), "can't change mode after allocation");
+  generational = polarity;
+  sweepMask = polarity ? 0 : MARKED;
+}
+
+void
+MemoryCell::rememberDagNode(DagNode* dagNode)
+{
+  //
+  //	Repeated in-place rewrites of the same node are common so we
+  //	avoid the most obvious duplicates.
+  //
+  std::lock_guard<std::mutex> lock(rememberedSetMutex);
+  int nrRemembered = rememberedSet.size();
+  if (nrRemembered == 0 || rememberedSet[nrRemembered - 1] != dagNode)
+    rememberedSet.append(dagNode);
+}
+
+void
+MemoryCell::requireMajorCollection()
+{
+  //
+  //	Old nodes in the remembered set might be garbage that points to
+  //	symbols that are about to be deleted, so we can't trace them in a
+  //	minor collection.
+  //
+  if (generational)
+    {
+      std::lock_guard<std::mutex> lock(rememberedSetMutex);
+      rememberedSet.clear();
+      majorThreshold = NONE;
+    }
+}
+
+void
+MemoryCell::setInitialHeapSize(size_t size)
+{
+  Assert(heaps.empty(), "can't change initial heap size after allocation");
+  initialHeapSize = size;
+}
+
+void
+MemoryCell::setGrowthFactor(double factor)
+{
+  growthFactor = factor;
+}
+
+void
+MemoryCell::setMaxHeapSize(size_t size)
+{
+  maxHeapSize = size;
+}
+
+bool
+MemoryCell::heapLimitExceeded()
+{
+  bool t = heapLimitFlag;
+  heapLimitFlag = false;
+  return t;
+}
+
+double
+MemoryCell::adaptiveGrowth(double survivalRate)
+{
+  //
+  //	If a collection leaves more live data than the growth factor allows
+  //	for, a larger fraction of what we allocate is surviving and
+  //	growing by the same factor would just bring the next collection
+  //	forward; so we boost the growth in proportion, up to a point.
+  //
+  double boost = survivalRate * growthFactor;
+  if (boost < 1.0)
+    boost = 1.0;
+  else if (boost > MAX_GROWTH_BOOST)
+    boost = MAX_GROWTH_BOOST;
+  return growthFactor * boost;
+}
+
+void
+MemoryCell::setNrGcThreads(int nrThreads)
+{
+  Assert(heaps.empty(), "can't change number of threads after allocation");
+  nrGcThreads = nrThreads;
+}
+
+void
+MemoryCell::markPhase()
+{
+  //
+  //	Remembered nodes are only present in a minor collection.
+  //
+  if (nrGcThreads == 1)
+    {
+      for (DagNode* d : rememberedSet)
+	d->mark();
+      RootContainer::markPhase();
+      return;
+    }
+  //
+  //	Collect the roots without marking them, and then mark everything
+  //	reachable from them in parallel.
+  //
+  Vector<DagNode*> roots;
+  markStack = &roots;
+  for (DagNode* d : rememberedSet)
+    d->mark();
+  RootContainer::markPhase();
+  markStack = 0;
+  ParallelMarker marker(nrGcThreads);
+  nrNodesInUse += marker.markFrom(roots);
+}
+
+void*
+MemoryCell::parallelAllocateStorage(size_t bytesNeeded)
+{
+  //
+  //	Each marking thread carves evacuation storage out of its own chunk
+  //	of bucket storage, and only needs to lock when it grabs a new chunk.
+  //
+  if (bytesNeeded > evacuationBytesFree)
+    {
+      std::lock_guard<std::mutex> lock(storageMutex);
+      if (bytesNeeded > EVACUATION_CHUNK_SIZE / 4)
+	return collectorHeap->allocateStorage(bytesNeeded);
+      evacuationChunk =
+	static_cast<char*>(collectorHeap->allocateStorage(EVACUATION_CHUNK_SIZE));
+      evacuationBytesFree = EVACUATION_CHUNK_SIZE;
+    }
+  void* t = evacuationChunk;
+  evacuationChunk += bytesNeeded;
+  evacuationBytesFree -= bytesNeeded;
+  return t;
+}
+
+void
+MemoryCell::Heap::clearAllMarks()
+{
+  //
+  //	In generational mode the marked flag means old rather than
+  //	reached in the most recent mark phase, and the lazy sweep never
+  //	clears it. So before a major collection we clear it everywhere.
+  //	Unmarked cells may be live young cells, so we don't touch them.
+  //
+  for (Arena* a = firstArena; a != 0; a = a->nextArena)
+    {
+      MemoryCell* e = a->firstNode() + ARENA_SIZE;
+      for (MemoryCell* d = a->firstNode(); d != e; d++)
+	d->clearFlag(MARKED);
+    }
+}
+
+void
+MemoryCell::minorCollection()
+{
+  ++nrMinorCollections;
+  int nrRemembered = 0;
+  for (DagNode* d : rememberedSet)
+    {
+      MemoryInfo* m = getMemoryInfo(d);
+      if (m->isMarked())
+	{
+	  m->clearFlag(MARKED);
+	  ++nrRemembered;
+	}
+    }
+  nrNodesInUse = 0;
+  markPhase();
+  int nrPromoted = nrNodesInUse - nrRemembered;
+  nrLiveNodes += nrPromoted;
+  rememberedSet.clear();
+  if (showGC)
+    {
+      cout << "Minor collection: " << nrMinorCollections <<
+	"\tRemembered: " << nrRemembered <<
+	"\tPromoted: " << nrPromoted <<
+	"\tOld: " << nrLiveNodes << '\n';
+    }
+}
+
 void
 MemoryCell::collectGarbage()
 {
-  if (firstArena == 0)
-    return;
-  tidyArenas();
+  std::unique_lock<std::mutex> lock(heapMutex);
+  if (collectionInProgress)
+    {
+      //
+      //	Another thread is collecting garbage and we are at a
+      //	safepoint, so we wait for it to finish.
+      //
+      Int64 collectionNr = nrCollections;
+      ++nrWaitingThreads;
+      safepoint.notify_all();
+      safepoint.wait(lock, [collectionNr]{ return nrCollections != collectionNr; });
+      --nrWaitingThreads;
+      return;
+    }
+  if (!(heap.needToCollectGarbage.load(std::memory_order_relaxed)))
+    return;  // nothing allocated or another thread collected since we checked
+  //
+  //	Ask every other attached thread to stop at its next safepoint
+  //	and wait until they have all done so.
+  //
+  collectionInProgress = true;
+  for (Heap* h : heaps)
+    h->needToCollectGarbage.store(true, std::memory_order_relaxed);
+  safepoint.wait(lock, []{ return nrWaitingThreads == nrAttachedThreads - 1; });
+  collectorHeap = &heap;
+  collectAllHeaps();
+  collectorHeap = 0;
+  collectionInProgress = false;
+  ++nrCollections;
+  safepoint.notify_all();
+}
+
+void
+MemoryCell::collectAllHeaps()
+{
+  if (generational)
+    {
+      bool overTarget = false;
+      for (Heap* h : heaps)
+	{
+	  if (h->storageInUse > h->target)
+	    overTarget = true;
+	}
+      if (!overTarget && nrLiveNodes <= majorThreshold)
+	{
+	  minorCollection();
+	  restartAllocation();
+	  return;
+	}
+      ++nrMajorCollections;
+      if (showGC)
+	{
+	  cout << "Major collection: " << nrMajorCollections <<
+	    "\tMinor collections: " << nrMinorCollections << '\n';
+	}
+      for (Heap* h : heaps)
+	h->clearAllMarks();
+      rememberedSet.clear();
+    }
+  else
+    {
+      for (Heap* h : heaps)
+	h->tidyArenas();
+    }
 #ifdef GC_DEBUG
-  checkArenas();
+  for (Heap* h : heaps)
+    h->checkArenas();
 #endif
   //
-  //	Mark phase
+  //	Mark phase; live bucket storage is evacuated to the buckets of
+  //	the collecting thread.
   //
   nrNodesInUse = 0;
-  size_t oldStorageInUse = storageInUse;
-  Bucket* b = bucketList;
-  bucketList = unusedList;
-  unusedList = 0;
-  storageInUse = 0;
+  size_t oldStorageInUse = 0;
+  for (Heap* h : heaps)
+    oldStorageInUse += h->storageInUse;
+  Bucket* b = heap.bucketList;
+  heap.bucketList = heap.unusedList;
+  heap.unusedList = 0;
+  heap.storageInUse = 0;
 
-  RootContainer::markPhase();
+  markPhase();
 
-  unusedList = b;
+  heap.unusedList = b;
   for (; b; b = b->nextBucket)
     {
       b->bytesFree = b->nrBytes;
       b->nextFree = b + 1;  // reset
     }
-  size_t newTarget = TARGET_MULTIPLIER * storageInUse;
-  if (target < newTarget)
-    target = newTarget;
+  int nrArenas = 0;
+  int nrBuckets = 0;
+  size_t bucketStorage = 0;
+  for (Heap* h : heaps)
+    {
+      if (h != &heap)
+	h->freeAllBuckets();
+      nrArenas += h->nrArenas;
+      nrBuckets += h->nrBuckets;
+      bucketStorage += h->bucketStorage;
+    }
+  size_t storageInUse = heap.storageInUse;
+  //
+  //	Bucket storage target grows with the same policy as arenas.
+  //
+  double survivalRate = (oldStorageInUse == 0) ? 0.0 :
+    static_cast<double>(storageInUse) / oldStorageInUse;
+  size_t newTarget = TARGET_MULTIPLIER / DEFAULT_GROWTH *
+    adaptiveGrowth(survivalRate) * storageInUse;
+  if (maxHeapSize != 0)
+    {
+      size_t arenaBytes = nrArenas * sizeof(Arena);
+      size_t maxTarget = (maxHeapSize > arenaBytes) ? maxHeapSize - arenaBytes : 0;
+      if (newTarget > maxTarget)
+	newTarget = max(maxTarget, storageInUse);
+      //
+      //	If the live data doesn't fit in the maximum heap there is no
+      //	point in continuing; we get the current computation abandoned
+      //	rather than wait for the operating system to kill us.
+      //
+      if (nrNodesInUse * sizeof(MemoryCell) + storageInUse > maxHeapSize)
+	{
+	  heapLimitFlag = true;
+	  RewritingContext::setTraceStatus(true);
+	}
+    }
+  for (Heap* h : heaps)
+    {
+      if (h->target < newTarget)
+	h->target = newTarget;
+    }
   //
   //	Calculate if we should allocate more arenas to avoid an early gc.
   //
@@ -340,10 +807,52 @@ MemoryCell::collectGarbage()
 	"\tCollected: " << oldStorageInUse - storageInUse <<
 	"\tNow: " << storageInUse << '\n';
     }
+  nrLiveNodes = nrNodesInUse;
+  majorThreshold = OLD_GENERATION_GROWTH * nrNodesInUse + ARENA_SIZE;
+  restartAllocation();
+}
+
+void
+MemoryCell::restartAllocation()
+{
   //
-  //	Allocate new arenas so that we have at least 50% of nodes unused.
+  //	Allocate new arenas so that the number of nodes exceeds the number
+  //	in use by the growth factor, subject to the maximum heap size. The
+  //	new arenas are shared between attached threads in proportion to
+  //	the arenas they already have.
   //
-  int neededArenas = ceilingDivision(2 * nrNodesInUse, ARENA_SIZE);
+  int nrArenas = 0;
+  int nrAttachedArenas = 0;
+  for (Heap* h : heaps)
+    {
+      nrArenas += h->nrArenas;
+      if (h->attached)
+	nrAttachedArenas += h->nrArenas;
+    }
+  if (nrAttachedArenas == 0)
+    nrAttachedArenas = 1;  // nothing to share
+  double survivalRate = (nrArenas == 0) ? 0.0 :
+    static_cast<double>(nrLiveNodes) / (nrArenas * ARENA_SIZE);
+  int neededArenas = ceil(adaptiveGrowth(survivalRate) * nrLiveNodes / ARENA_SIZE);
+  if (maxHeapSize != 0)
+    {
+      int maxArenas = maxHeapSize / sizeof(Arena);
+      if (neededArenas > maxArenas)
+	neededArenas = maxArenas;
+    }
+  for (Heap* h : heaps)
+    {
+      h->restartAllocation(h->attached ?
+			   ceil(static_cast<double>(neededArenas) * h->nrArenas / nrAttachedArenas) : 0);
+    }
+}
+
+void
+MemoryCell::Heap::restartAllocation(int neededArenas)
+{
+  needToCollectGarbage.store(false, std::memory_order_relaxed);
+  if (firstArena == 0)
+    return;  // nothing allocated
   while (nrArenas < neededArenas)
     (void) allocateNewArena();
   //
@@ -354,7 +863,6 @@ MemoryCell::collectGarbage()
   nextNode = currentArena->firstNode();
   endPointer = nextNode +
     ((firstArena->nextArena != 0) ? ARENA_SIZE : ARENA_SIZE - RESERVE_SIZE);
-  needToCollectGarbage = false;
 #ifdef GC_DEBUG
   // stompArenas();
   cerr << "end of GC\n";
@@ -364,7 +872,7 @@ MemoryCell::collectGarbage()
 
 #ifdef GC_DEBUG
 void
-MemoryCell::stompArenas()
+MemoryCell::Heap::stompArenas()
 {
   for (Arena* a = firstArena; a != 0; a = a->nextArena)
     {
@@ -378,7 +886,7 @@ MemoryCell::stompArenas()
 }
 
 void
-MemoryCell::checkArenas()
+MemoryCell::Heap::checkArenas()
 {
   int n = 0;
   for (Arena* a = firstArena; a != 0; a = a->nextArena, n++)
@@ -396,9 +904,11 @@ MemoryCell::checkArenas()
 }
 
 void
-MemoryCell::checkInvariant()
+MemoryCell::Heap::checkInvariant()
 {
   int n = 0;
+  if (currentArena == 0)
+    return;
   for (Arena* a = firstArena;; a = a->nextArena, n++)
     {
       MemoryCell* d = a->firstNode();
@@ -417,10 +927,10 @@ MemoryCell::checkInvariant()
 }
 
 void
-MemoryCell::dumpMemoryVariables(ostream& s)
+MemoryCell::Heap::dumpMemoryVariables(ostream& s)
 {
   s << "nrArenas = " << nrArenas <<
-    "\nnrNodesInUse = " << nrNodesInUse <<
+    "\nnrLiveNodes = " << nrLiveNodes <<
     "\ncurrentArenaPastActiveArena = " << currentArenaPastActiveArena <<
     "\nneedToCollectGarbage = " << needToCollectGarbage <<
     "\nfirstArena = " << firstArena <<
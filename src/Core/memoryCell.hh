@@ -25,6 +25,7 @@
 //
 #ifndef _memoryCell_hh_
 #define _memoryCell_hh_
+#include <atomic>
 #include "memoryInfo.hh"
 #include "memoryBlock.hh"
 #include "sort.hh"
@@ -60,6 +61,53 @@ public:
   static void collectGarbage();
 
   static void setShowGC(bool polarity);
+  //
+  //	The mark phase can be shared between several threads. Must be
+  //	chosen before any allocation.
+  //
+  static void setNrGcThreads(int nrThreads);
+  //
+  //	Heap sizing; sizes are in bytes and a maximum size of 0 means no
+  //	limit. The initial size must be set before any allocation.
+  //
+  static void setInitialHeapSize(size_t size);
+  static void setGrowthFactor(double factor);
+  static void setMaxHeapSize(size_t size);
+  //
+  //	Returns true, once, if a garbage collection found more live data
+  //	than the maximum heap size allows; the trace status is also set so
+  //	that rewriting gets off the fast path and can check this.
+  //
+  static bool heapLimitExceeded();
+  //
+  //	In generational mode cells that survive a garbage collection are
+  //	promoted to an old generation that is only traced by major
+  //	collections; minor collections just trace cells allocated since
+  //	the previous collection. Must be chosen before any allocation.
+  //
+  static void setGenerational(bool polarity);
+  //
+  //	In generational mode an old dag node must be reported after any
+  //	garbage collection that precedes its in-place modification, since
+  //	it may then point to young cells that a minor collection would not
+  //	otherwise find.
+  //
+  static void writeBarrier(DagNode* dagNode);
+  //
+  //	Called before symbols are deleted; the next garbage collection
+  //	will then be a major one.
+  //
+  static void requireMajorCollection();
+  //
+  //	Each thread allocates from its own heap, and a garbage collection
+  //	waits until every other attached thread reaches a safepoint, i.e. a
+  //	call to okToCollectGarbage() or collectGarbage(). A thread attaches
+  //	on its first allocation and detaches when it exits; a thread that
+  //	is about to block for another thread must detach first, and while
+  //	detached, its live dags must be reachable from root containers.
+  //
+  static void attachThread();
+  static void detachThread();
 
   //
   //	We provide functions for getting access to the MemoryInfo object
@@ -67,6 +115,13 @@ public:
   //
   static MemoryInfo* getMemoryInfo(void* p);
   static const MemoryInfo* getMemoryInfo(const void* p);
+  //
+  //	During a parallel mark phase, DagNode::mark() just pushes the
+  //	node on the current thread's mark stack, and storage used to
+  //	evacuate argument vectors must be allocated via a thread-safe path.
+  //
+  static bool deferMark(DagNode* dagNode);
+  static void* allocateEvacuationStorage(size_t bytesNeeded);
 
 private:
   enum MemoryManagementParameters
@@ -77,48 +132,58 @@ private:
     BUCKET_MULTIPLIER = 8,	// to determine bucket size for huge allocations
     MIN_BUCKET_SIZE = 256 * 1024 - 8,	// bucket size for normal allocations
     INITIAL_TARGET = 220 * 1024,	// just under 8/9 of MIN_BUCKET_SIZE
-    TARGET_MULTIPLIER = 8	// to determine bucket usage target
+    TARGET_MULTIPLIER = 8,	// to determine bucket usage target
+    DEFAULT_GROWTH = 2,		// ratio of nodes to nodes in use after GC
+    MAX_GROWTH_BOOST = 4,	// limit on adaptive growth
+    OLD_GENERATION_GROWTH = 2,	// major collection when old generation grows by this factor
+    EVACUATION_CHUNK_SIZE = 8 * 1024	// bucket storage grabbed by a marking thread at once
   };
 
   struct Arena;			// arena of fixed size nodes
   struct Bucket;		// bucket of variable length allocations
+  struct Heap;			// per thread arenas and buckets
 
   static bool showGC;		// do we report GC stats to user
   //
-  //	Arena management variables.
+  //	Heap sizing variables.
   //
-  static int nrArenas;
-  //static int nrNodesInUse;
-  static bool currentArenaPastActiveArena;
-  static bool needToCollectGarbage;
-  static Arena* firstArena;
-  static Arena* lastArena;
-  static Arena* currentArena;
-  static MemoryCell* nextNode;
-  static MemoryCell* endPointer;
-  static Arena* lastActiveArena;
-  static MemoryCell* lastActiveNode;
+  static size_t initialHeapSize;
+  static double growthFactor;
+  static size_t maxHeapSize;
+  static bool heapLimitFlag;
   //
-  //	Bucket management variables.
+  //	Generational mode variables.
   //
-  static int nrBuckets;		// total number of buckets
-  static Bucket* bucketList;	// linked list of "in use" buckets
-  static Bucket* unusedList;	// linked list of unused buckets
-  static size_t bucketStorage;	// total amount of bucket storage (bytes)
-  static size_t storageInUse;	// amount of bucket storage in use (bytes)
-  static size_t target;		// amount to use before GC (bytes)
+  static bool generational;
+  static int sweepMask;		// flags cleared by lazy sweep
+  static Vector<DagNode*> rememberedSet;	// old nodes modified since last collection
+  static int majorThreshold;	// number of old nodes that triggers a major collection
+  static Int64 nrMinorCollections;
+  static Int64 nrMajorCollections;
+  //
+  //	Parallel marking variables.
+  //
+  static int nrGcThreads;
+  static thread_local Vector<DagNode*>* markStack;	// only used by parallel mark phase
+  static thread_local char* evacuationChunk;
+  static thread_local size_t evacuationBytesFree;
+  //
+  //	Per thread heap variables.
+  //
+  static thread_local Heap heap;	// heap of the current thread
+  static Vector<Heap*> heaps;	// heaps of attached threads and abandoned heaps
+  static Heap* collectorHeap;	// heap of thread doing garbage collection
+  static int nrLiveNodes;	// live nodes found by most recent collection
 
-  static Arena* allocateNewArena();
-  static void tidyArenas();
-  static MemoryCell* slowNew();
-  static void* slowAllocateStorage(size_t bytesNeeded);
+  static void collectAllHeaps();
+  static void minorCollection();
+  static void restartAllocation();
+  static void rememberDagNode(DagNode* dagNode);
+  static void markPhase();
+  static double adaptiveGrowth(double survivalRate);
+  static void* parallelAllocateStorage(size_t bytesNeeded);
 
-#ifdef GC_DEBUG
-  static void stompArenas();
-  static void checkArenas();
-  static void checkInvariant();
-  static void dumpMemoryVariables(ostream& s);
-#endif
+  friend class ParallelMarker;
 };
 
 struct MemoryCell::Bucket
@@ -129,27 +194,58 @@ struct MemoryCell::Bucket
   Bucket* nextBucket;
 }; 
 
-inline void
-MemoryCell::okToCollectGarbage()
+struct MemoryCell::Heap
 {
-  if (needToCollectGarbage)
-    collectGarbage();
-}
+  void copy(const Heap& other);
+  Arena* allocateNewArena();
+  MemoryCell* slowNew();
+  MemoryCell* lazySweep();
+  void* allocateStorage(size_t bytesNeeded);
+  void* slowAllocateStorage(size_t bytesNeeded);
+  void tidyArenas();
+  void clearAllMarks();
+  void freeAllBuckets();
+  void restartAllocation(int neededArenas);
+#ifdef GC_DEBUG
+  void stompArenas();
+  void checkArenas();
+  void checkInvariant();
+  void dumpMemoryVariables(ostream& s);
+#endif
 
-inline bool
-MemoryCell::wantToCollectGarbage()
-{
-  return needToCollectGarbage;
-}
+  bool attached = false;	// belongs to a running thread
+  std::atomic<bool> needToCollectGarbage = {false};
+  //
+  //	Arena management variables.
+  //
+  int nrArenas = 0;
+  bool currentArenaPastActiveArena = true;
+  Arena* firstArena = 0;
+  Arena* lastArena = 0;
+  Arena* currentArena = 0;
+  MemoryCell* nextNode = 0;
+  MemoryCell* endPointer = 0;
+  Arena* lastActiveArena = 0;
+  MemoryCell* lastActiveNode = 0;
+  //
+  //	Bucket management variables.
+  //
+  int nrBuckets = 0;		// total number of buckets
+  Bucket* bucketList = 0;	// linked list of "in use" buckets
+  Bucket* unusedList = 0;	// linked list of unused buckets
+  size_t bucketStorage = 0;	// total amount of bucket storage (bytes)
+  size_t storageInUse = 0;	// amount of bucket storage in use (bytes)
+  size_t target = INITIAL_TARGET;	// amount to use before GC (bytes)
+};
 
 inline void*
-MemoryCell::allocateStorage(size_t bytesNeeded)
+MemoryCell::Heap::allocateStorage(size_t bytesNeeded)
 {
   Assert(bytesNeeded % sizeof(MachineWord) == 0,
 	 "only whole machine words can be allocated");
   storageInUse += bytesNeeded;
   if (storageInUse > target)
-    needToCollectGarbage = true;
+    needToCollectGarbage.store(true, std::memory_order_relaxed);
   for (Bucket* b = bucketList; b; b = b->nextBucket)
     {
       if (b->bytesFree >= bytesNeeded)
@@ -163,6 +259,49 @@ MemoryCell::allocateStorage(size_t bytesNeeded)
   return slowAllocateStorage(bytesNeeded);
 }
 
+inline void
+MemoryCell::okToCollectGarbage()
+{
+  if (heap.needToCollectGarbage.load(std::memory_order_relaxed))
+    collectGarbage();
+}
+
+inline void
+MemoryCell::writeBarrier(DagNode* dagNode)
+{
+  if (generational && getMemoryInfo(dagNode)->isMarked())
+    rememberDagNode(dagNode);
+}
+
+inline bool
+MemoryCell::deferMark(DagNode* dagNode)
+{
+  Vector<DagNode*>* s = markStack;
+  if (s == 0)
+    return false;
+  s->append(dagNode);
+  return true;
+}
+
+inline void*
+MemoryCell::allocateEvacuationStorage(size_t bytesNeeded)
+{
+  return (markStack == 0) ? allocateStorage(bytesNeeded) :
+    parallelAllocateStorage(bytesNeeded);
+}
+
+inline bool
+MemoryCell::wantToCollectGarbage()
+{
+  return heap.needToCollectGarbage.load(std::memory_order_relaxed);
+}
+
+inline void*
+MemoryCell::allocateStorage(size_t bytesNeeded)
+{
+  return heap.allocateStorage(bytesNeeded);
+}
+
 inline void
 MemoryCell::setShowGC(bool polarity)
 {
@@ -173,16 +312,16 @@ inline void*
 MemoryCell::allocateMemoryCell()
 {
 #ifdef GC_DEBUG
-  checkInvariant();
+  heap.checkInvariant();
 #endif
 
-  MemoryCell* e = endPointer;
-  MemoryCell* c = nextNode;
+  MemoryCell* e = heap.endPointer;
+  MemoryCell* c = heap.nextNode;
   for (;; ++c)
     {
       if (c == e)
        {
-         c = slowNew();
+         c = heap.slowNew();
          break;
        }
       if (c->simpleReuse())
@@ -192,10 +331,10 @@ MemoryCell::allocateMemoryCell()
 	  c->callDtor();
 	  break;
 	}
-      c->clearFlag(MARKED);
+      c->clearFlag(sweepMask);
     }
   // could clear flags here
-  nextNode = c + 1;
+  heap.nextNode = c + 1;
   MemoryBlock* b = c;
   return b;
 }
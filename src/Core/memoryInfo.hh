@@ -61,6 +61,11 @@ public:
   //
   bool isMarked() const;
   void setMarked();
+  //
+  //	Thread-safe version of setMarked() for parallel marking; returns
+  //	false if the cell was already marked.
+  //
+  bool tryToMark();
   bool needToCallDtor() const;
   void setCallDtor();
   bool simpleReuse() const;
@@ -129,11 +134,21 @@ MemoryInfo::isMarked() const
 inline void
 MemoryInfo::setMarked()
 {
-  extern int nrNodesInUse;  // FIXME
+  extern thread_local int nrNodesInUse;  // FIXME
   ++nrNodesInUse;
   setFlag(MARKED);
 }
 
+inline bool
+MemoryInfo::tryToMark()
+{
+  extern thread_local int nrNodesInUse;  // FIXME
+  if (__atomic_fetch_or(&flags, MARKED, __ATOMIC_RELAXED) & MARKED)
+    return false;
+  ++nrNodesInUse;
+  return true;
+}
+
 inline bool
 MemoryInfo::needToCallDtor() const
 {
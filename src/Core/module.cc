@@ -41,10 +41,12 @@
 #include "equation.hh"
 #include "rule.hh"
 #include "sortBdds.hh"
+#include "memoryCell.hh"
 #include "memoMap.hh"
 #include "module.hh"
 #include "strategyDefinition.hh"
 #include "rewriteStrategy.hh"
+#include "sortInfoCache.hh"
 
 //	variable class definitions
 #include "variableTerm.hh"
@@ -86,8 +88,11 @@ Module::~Module()
   for (RewriteStrategy* rs : strategies)
     delete rs;
   //
-  //	And finally it is safe to delete our symbols.
+  //	And finally it is safe to delete our symbols, once we make sure
+  //	that a minor garbage collection won't try to trace old dag nodes
+  //	that might contain pointers to them.
   //
+  MemoryCell::requireMajorCollection();
 #if 1
   for (Symbol* s : symbols)
     delete s;
@@ -235,6 +240,10 @@ Module::closeTheory()
   //	voluminous sort tables we postpone it we are actually going to
   //	do some useful work in the module.
   //
+  //	If we have a module cache, sort computations that were done in an
+  //	earlier run are looked up rather than repeated.
+  //
+  SortInfoCache* sortInfoCache = SortInfoCache::enabled() ? new SortInfoCache(this) : 0;
   for (Symbol* s : symbols)
     s->compileOpDeclarations();
   //
@@ -281,6 +290,7 @@ Module::closeTheory()
   //
   for (Symbol* s : symbols)
     s->finalizeSortInfo();
+  delete sortInfoCache;  // writes out any new sort computations
   //
   //	Now index equations and rules and compile statements.
   //
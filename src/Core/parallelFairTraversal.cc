@@ -0,0 +1,206 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//      Implementation for class ParallelFairTraversal.
+//
+#include <signal.h>
+#include <thread>
+#include <vector>
+
+//	utility stuff
+#include "macros.hh"
+#include "vector.hh"
+#include "pointerMap.hh"
+
+//	forward declarations
+#include "interface.hh"
+#include "core.hh"
+
+//	interface class definitions
+#include "symbol.hh"
+#include "dagNode.hh"
+#include "dagArgumentIterator.hh"
+
+//	core class definitions
+#include "memoryCell.hh"
+#include "redexPosition.hh"
+#include "rewritingContext.hh"
+#include "parallelFairTraversal.hh"
+
+thread_local bool ParallelFairTraversal::workerFlag = false;
+
+ParallelFairTraversal::ParallelFairTraversal(int nrThreads)
+  : nrThreads(nrThreads)
+{
+  gasPerNode = 1;
+  nextGroup = 0;
+}
+
+ParallelFairTraversal::~ParallelFairTraversal()
+{
+  for (RewritingContext* c : subcontexts)
+    delete c;
+}
+
+bool
+ParallelFairTraversal::traverseArguments(RewritingContext& parent, int firstArgIndex)
+{
+  Vector<RedexPosition>& redexStack = parent.redexStack;
+  int nrArguments = redexStack.size() - firstArgIndex;
+  for (int i = 0; i < nrArguments; ++i)
+    {
+      const RedexPosition& rp = redexStack[firstArgIndex + i];
+      RewritingContext* c = parent.makeFairSubcontext(rp.node());
+      if (c == 0)
+	return false;  // parent can't hand off fair rewriting
+      arguments.append(rp.node());
+      eager.append(rp.isEager());
+      subcontexts.append(c);
+    }
+  groupArguments();
+  if (groups.size() < 2)
+    return false;  // nothing to gain
+  //
+  //	The calling thread waits for the workers without allocating, so
+  //	it detaches to let them garbage collect; its live dags are all
+  //	reachable from the parent context.
+  //
+  gasPerNode = parent.gasPerNode;
+  int nrWorkers = min(nrThreads, static_cast<int>(groups.size()));
+  MemoryCell::detachThread();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nrWorkers; ++i)
+    threads.emplace_back(&ParallelFairTraversal::worker, this);
+  for (std::thread& t : threads)
+    t.join();
+  MemoryCell::attachThread();
+  //
+  //	Take back results and counts. Counts are added in argument order
+  //	so that the totals don't depend on how the work was shared out.
+  //
+  for (int i = 0; i < nrArguments; ++i)
+    {
+      RewritingContext* c = subcontexts[i];
+      RedexPosition& rp = redexStack[firstArgIndex + i];
+      DagNode* r = c->root();
+      if (r != rp.node())
+	{
+	  rp.replaceNode(r);
+	  parent.staleMarker = rp.parentIndex();
+	}
+      if (c->getProgress())
+	parent.progress = true;
+      parent.addInCount(*c);
+    }
+  return true;
+}
+
+void
+ParallelFairTraversal::groupArguments()
+{
+  //
+  //	Arguments end up in the same group if they share a dag node. We
+  //	visit the nodes of each argument, recording which argument visited
+  //	them first. Constants that are already unstackable are ignored
+  //	since a traversal can't rewrite them or change their flags.
+  //
+  int nrArguments = arguments.size();
+  groupParent.resize(nrArguments);
+  for (int i = 0; i < nrArguments; ++i)
+    groupParent[i] = i;
+  PointerMap firstVisitor(2 * nrArguments);
+  Vector<DagNode*> stack;
+  for (int i = 0; i < nrArguments; ++i)
+    {
+      stack.append(arguments[i]);
+      do
+	{
+	  DagNode* d = stack[stack.size() - 1];
+	  stack.contractTo(stack.size() - 1);
+	  if (d->symbol()->arity() == 0 && d->isUnstackable())
+	    continue;
+	  if (void* v = firstVisitor.getMap(d))
+	    {
+	      int j = findGroup(static_cast<int>(reinterpret_cast<intptr_t>(v)) - 1);
+	      int k = findGroup(i);
+	      if (j != k)
+		groupParent[j] = k;
+	      continue;  // arguments of d already seen
+	    }
+	  firstVisitor.setMap(d, reinterpret_cast<void*>(static_cast<intptr_t>(i + 1)));
+	  for (DagArgumentIterator a(d); a.valid(); a.next())
+	    stack.append(a.argument());
+	}
+      while (!stack.empty());
+    }
+  //
+  //	Collect groups, keeping arguments in order within each group.
+  //
+  Vector<int> groupNr(nrArguments);
+  for (int i = 0; i < nrArguments; ++i)
+    {
+      int root = findGroup(i);
+      if (root == i)
+	{
+	  groupNr[i] = groups.size();
+	  groups.expandBy(1);
+	}
+    }
+  for (int i = 0; i < nrArguments; ++i)
+    groups[groupNr[findGroup(i)]].append(i);
+}
+
+int
+ParallelFairTraversal::findGroup(int argNr)
+{
+  while (groupParent[argNr] != argNr)
+    {
+      int grandParent = groupParent[groupParent[argNr]];
+      groupParent[argNr] = grandParent;
+      argNr = grandParent;
+    }
+  return argNr;
+}
+
+void
+ParallelFairTraversal::worker()
+{
+  sigset_t allSignals;
+  sigfillset(&allSignals);
+  pthread_sigmask(SIG_BLOCK, &allSignals, 0);
+  workerFlag = true;
+
+  int nrGroups = groups.size();
+  for (;;)
+    {
+      int g = nextGroup.fetch_add(1, std::memory_order_relaxed);
+      if (g >= nrGroups)
+	break;
+      for (int i : groups[g])
+	{
+	  RewritingContext* c = subcontexts[i];
+	  c->fairTraversalOfSubterm(eager[i], gasPerNode);
+	  (void) c->root();  // rebuild on this thread
+	}
+    }
+}
@@ -0,0 +1,81 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	Class for doing the part of a fair rewriting traversal below a
+//	node with many stacked arguments using several threads.
+//
+//	Each stacked argument gets its own subcontext, in which a single
+//	fair traversal of that argument is done, just as the parent context
+//	would have done it; the results and rewrite counts are then taken
+//	back by the parent context, which carries on with the traversal from
+//	the node above. Arguments that share dag nodes are always traversed
+//	by the same thread, one after another, since some theories change the
+//	representation of a dag node in place and flags are set on shared nodes.
+//
+//	Threads only live for a single traversal, and block all signals so
+//	that interrupts are seen by the thread running the parent context.
+//
+#ifndef _parallelFairTraversal_hh_
+#define _parallelFairTraversal_hh_
+#include <atomic>
+
+class ParallelFairTraversal
+{
+  NO_COPYING(ParallelFairTraversal);
+
+public:
+  ParallelFairTraversal(int nrThreads);
+  ~ParallelFairTraversal();
+  //
+  //	Tries to do the traversal of the arguments stacked at or above
+  //	firstArgIndex in parent's redex stack; returns false without
+  //	rewriting anything if that isn't possible or isn't worthwhile.
+  //
+  bool traverseArguments(RewritingContext& parent, int firstArgIndex);
+
+  static bool onWorkerThread();
+
+private:
+  void groupArguments();
+  int findGroup(int argNr);
+  void worker();
+
+  static thread_local bool workerFlag;
+
+  const int nrThreads;
+  Vector<DagNode*> arguments;
+  Vector<bool> eager;
+  Vector<RewritingContext*> subcontexts;
+  Vector<int> groupParent;		// union-find forest over arguments
+  Vector<Vector<int> > groups;		// arguments in each group
+  Int64 gasPerNode;
+  std::atomic<int> nextGroup;
+};
+
+inline bool
+ParallelFairTraversal::onWorkerThread()
+{
+  return workerFlag;
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//      Implementation for class ParallelMarker.
+//
+#include <thread>
+#include <vector>
+
+//	utility stuff
+#include "macros.hh"
+#include "vector.hh"
+
+//	forward declarations
+#include "interface.hh"
+#include "core.hh"
+
+//	interface class definitions
+#include "dagNode.hh"
+
+//	core class definitions
+#include "memoryCell.hh"
+#include "parallelMarker.hh"
+
+extern thread_local int nrNodesInUse;
+
+ParallelMarker::ParallelMarker(int nrThreads)
+  : nrThreads(nrThreads)
+{
+  nrWaiting = 0;
+  finished = false;
+  nrHungry = 0;
+  otherThreadsNrNodes = 0;
+}
+
+int
+ParallelMarker::markFrom(const Vector<DagNode*>& roots)
+{
+  //
+  //	The roots form the initial pool of work.
+  //
+  int nrRoots = roots.size();
+  for (int i = 0; i < nrRoots; i += MIN_DONATION)
+    {
+      int end = min(i + MIN_DONATION, nrRoots);
+      Vector<DagNode*> chunk(end - i);
+      for (int j = i; j < end; ++j)
+	chunk[j - i] = roots[j];
+      int nrChunks = pool.size();
+      pool.expandBy(1);
+      pool[nrChunks].swap(chunk);
+    }
+  std::vector<std::thread> threads;
+  for (int i = 1; i < nrThreads; ++i)
+    threads.emplace_back(&ParallelMarker::worker, this);
+  //
+  //	Calling thread does its share of the work, and counts the nodes
+  //	it marks directly in its own nrNodesInUse.
+  //
+  Vector<DagNode*> stack;
+  MemoryCell::markStack = &stack;
+  markAll(stack);
+  MemoryCell::markStack = 0;
+  MemoryCell::evacuationChunk = 0;
+  MemoryCell::evacuationBytesFree = 0;
+
+  for (std::thread& t : threads)
+    t.join();
+  return otherThreadsNrNodes;
+}
+
+void
+ParallelMarker::worker()
+{
+  Vector<DagNode*> stack;
+  MemoryCell::markStack = &stack;
+  markAll(stack);
+  MemoryCell::markStack = 0;
+  std::lock_guard<std::mutex> lock(poolMutex);
+  otherThreadsNrNodes += nrNodesInUse;
+}
+
+void
+ParallelMarker::markAll(Vector<DagNode*>& stack)
+{
+  for (;;)
+    {
+      int nrPending = stack.size();
+      if (nrPending == 0)
+	{
+	  if (!getWork(stack))
+	    break;
+	  continue;
+	}
+      DagNode* d = stack[nrPending - 1];
+      stack.contractTo(nrPending - 1);
+      //
+      //	Whichever thread sets the marked flag owns the node and is
+      //	responsible for its arguments. As with DagNode::mark() we
+      //	don't stack the last argument.
+      //
+      while (d != 0 && d->getMemoryInfo()->tryToMark())
+	d = d->markArguments();
+      if (nrHungry.load(std::memory_order_relaxed) > 0 &&
+	  stack.size() >= 2 * MIN_DONATION)
+	donateWork(stack);
+    }
+}
+
+bool
+ParallelMarker::getWork(Vector<DagNode*>& stack)
+{
+  std::unique_lock<std::mutex> lock(poolMutex);
+  ++nrHungry;
+  for (;;)
+    {
+      int nrChunks = pool.size();
+      if (nrChunks > 0)
+	{
+	  stack.swap(pool[nrChunks - 1]);
+	  pool.contractTo(nrChunks - 1);
+	  --nrHungry;
+	  return true;
+	}
+      if (finished)
+	break;
+      if (nrWaiting == nrThreads - 1)
+	{
+	  //
+	  //	Everyone else is waiting for work so there is none left.
+	  //
+	  finished = true;
+	  workAvailable.notify_all();
+	  break;
+	}
+      ++nrWaiting;
+      workAvailable.wait(lock);
+      --nrWaiting;
+    }
+  --nrHungry;
+  return false;
+}
+
+void
+ParallelMarker::donateWork(Vector<DagNode*>& stack)
+{
+  //
+  //	We donate the older half of our stack since it is closer to the
+  //	roots and likely to represent more work.
+  //
+  int nrPending = stack.size();
+  int nrDonated = nrPending / 2;
+  Vector<DagNode*> chunk(nrDonated);
+  for (int i = 0; i < nrDonated; ++i)
+    chunk[i] = stack[i];
+  for (int i = nrDonated; i < nrPending; ++i)
+    stack[i - nrDonated] = stack[i];
+  stack.contractTo(nrPending - nrDonated);
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    int nrChunks = pool.size();
+    pool.expandBy(1);
+    pool[nrChunks].swap(chunk);
+  }
+  workAvailable.notify_one();
+}
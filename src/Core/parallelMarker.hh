@@ -0,0 +1,74 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	Class for marking the dag nodes reachable from a set of roots using
+//	several threads.
+//
+//	Each thread has a private mark stack; when some thread runs out of
+//	work, the others donate the older half of their stacks to a shared
+//	pool that idle threads take work from. Marking is finished when every
+//	thread is idle and the pool is empty.
+//
+//	Threads only live for a single mark phase, so that forking worker
+//	processes is never complicated by idle garbage collector threads.
+//
+#ifndef _parallelMarker_hh_
+#define _parallelMarker_hh_
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+class ParallelMarker
+{
+  NO_COPYING(ParallelMarker);
+
+public:
+  ParallelMarker(int nrThreads);
+  //
+  //	Returns the number of nodes marked by threads other than the
+  //	caller; the caller's count is added to its own nrNodesInUse.
+  //
+  int markFrom(const Vector<DagNode*>& roots);
+
+private:
+  enum Parameters
+  {
+    MIN_DONATION = 64		// don't bother donating smaller chunks
+  };
+
+  void worker();
+  void markAll(Vector<DagNode*>& stack);
+  bool getWork(Vector<DagNode*>& stack);
+  void donateWork(Vector<DagNode*>& stack);
+
+  const int nrThreads;
+  std::mutex poolMutex;
+  std::condition_variable workAvailable;
+  Vector<Vector<DagNode*> > pool;	// donated chunks of work
+  int nrWaiting;			// threads waiting for work
+  bool finished;
+  std::atomic<int> nrHungry;		// threads that would like donations
+  int otherThreadsNrNodes;		// nodes marked by other threads
+};
+
+#endif
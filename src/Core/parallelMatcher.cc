@@ -0,0 +1,115 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//      Implementation for class ParallelMatcher.
+//
+#include <signal.h>
+#include <thread>
+#include <vector>
+
+//	utility stuff
+#include "macros.hh"
+#include "vector.hh"
+
+//	forward declarations
+#include "interface.hh"
+#include "core.hh"
+
+//	interface class definitions
+#include "dagNode.hh"
+#include "lhsAutomaton.hh"
+
+//	core class definitions
+#include "memoryCell.hh"
+#include "substitution.hh"
+#include "localBinding.hh"
+#include "parallelMatcher.hh"
+
+int ParallelMatcher::nrThreads = 1;
+thread_local bool ParallelMatcher::enabled = false;
+thread_local bool ParallelMatcher::workerFlag = false;
+
+ParallelMatcher::ParallelMatcher(LhsAutomaton* automaton, const Substitution& solution)
+  : automaton(automaton),
+    solution(solution)
+{
+  subjects = 0;
+  matches = 0;
+}
+
+void
+ParallelMatcher::matchSubjects(const Vector<DagNode*>& subjects, Vector<Match>& matches)
+{
+  int nrSubjects = subjects.size();
+  matches.resize(nrSubjects);
+  this->subjects = &subjects;
+  this->matches = &matches;
+  nextSubject = 0;
+  //
+  //	Workers don't collect garbage, and the dags they make are only
+  //	reachable from their results, so we can detach while we wait.
+  //
+  int nrWorkers = min(nrThreads, (nrSubjects + CHUNK_SIZE - 1) / CHUNK_SIZE);
+  MemoryCell::detachThread();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nrWorkers; ++i)
+    threads.emplace_back(&ParallelMatcher::worker, this);
+  for (std::thread& t : threads)
+    t.join();
+  MemoryCell::attachThread();
+}
+
+void
+ParallelMatcher::worker()
+{
+  sigset_t allSignals;
+  sigfillset(&allSignals);
+  pthread_sigmask(SIG_BLOCK, &allSignals, 0);
+  workerFlag = true;
+
+  int nrSubjects = subjects->size();
+  Substitution local(solution.nrFragileBindings());
+  for (;;)
+    {
+      int first = nextSubject.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+      if (first >= nrSubjects)
+	break;
+      int end = min(first + static_cast<int>(CHUNK_SIZE), nrSubjects);
+      for (int i = first; i < end; ++i)
+	{
+	  Match& m = (*matches)[i];
+	  m.matched = false;
+	  if (DagNode* d = (*subjects)[i])
+	    {
+	      local.copy(solution);
+	      Subproblem* sp;
+	      if (automaton->match(d, local, sp))
+		{
+		  m.matched = true;
+		  m.difference = local - solution;
+		  m.subproblem = sp;
+		}
+	    }
+	}
+    }
+}
@@ -0,0 +1,130 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	Class for matching one subpattern against many subjects using
+//	several threads, for theories that build match alternatives by
+//	trying a subpattern against each argument of a large subject.
+//
+//	Each subject is matched against a private copy of the substitution,
+//	just as the sequential code would have done it, and the outcome is
+//	recorded by subject index so the caller can use the alternatives in
+//	exactly the order it would have found them itself.
+//
+//	Matching on a worker thread must not change the representation of
+//	a subject in place, since subjects may share subterms; theories that
+//	would do so check onWorkerThread() and work on a copy instead.
+//
+//	Parallel matching is only done on a thread with a Scope object alive,
+//	and never nested.
+//
+#ifndef _parallelMatcher_hh_
+#define _parallelMatcher_hh_
+#include <atomic>
+
+class ParallelMatcher
+{
+  NO_COPYING(ParallelMatcher);
+
+public:
+  struct Match
+  {
+    bool matched;
+    LocalBinding* difference;
+    Subproblem* subproblem;
+  };
+
+  class Scope
+  {
+    NO_COPYING(Scope);
+
+  public:
+    Scope();
+    ~Scope();
+
+  private:
+    const bool saved;
+  };
+
+  ParallelMatcher(LhsAutomaton* automaton, const Substitution& solution);
+  //
+  //	Tries automaton against each non-null subject; matches is resized
+  //	to hold an entry for each subject.
+  //
+  void matchSubjects(const Vector<DagNode*>& subjects, Vector<Match>& matches);
+
+  static void setNrThreads(int nrThreads);
+  static bool worthwhile(int nrSubjects);
+  static bool onWorkerThread();
+
+private:
+  enum Values
+  {
+    MIN_SUBJECTS = 256,	// don't start threads for fewer subjects than this
+    CHUNK_SIZE = 32	// subjects taken by a worker at once
+  };
+
+  void worker();
+
+  static int nrThreads;
+  static thread_local bool enabled;
+  static thread_local bool workerFlag;
+
+  LhsAutomaton* const automaton;
+  const Substitution& solution;
+  const Vector<DagNode*>* subjects;
+  Vector<Match>* matches;
+  std::atomic<int> nextSubject;
+};
+
+inline
+ParallelMatcher::Scope::Scope()
+  : saved(enabled)
+{
+  enabled = true;
+}
+
+inline
+ParallelMatcher::Scope::~Scope()
+{
+  enabled = saved;
+}
+
+inline void
+ParallelMatcher::setNrThreads(int nrThreads)
+{
+  ParallelMatcher::nrThreads = nrThreads;
+}
+
+inline bool
+ParallelMatcher::worthwhile(int nrSubjects)
+{
+  return nrThreads > 1 && enabled && nrSubjects >= MIN_SUBJECTS && !workerFlag;
+}
+
+inline bool
+ParallelMatcher::onWorkerThread()
+{
+  return workerFlag;
+}
+
+#endif
@@ -38,10 +38,12 @@
 
 //	core class definitions
 #include "rewritingContext.hh"
+#include "parallelFairTraversal.hh"
 
 #include "run.cc"
 
-bool RewritingContext::traceFlag = false;
+thread_local bool RewritingContext::traceFlag = false;
+int RewritingContext::nrFairThreads = 1;
 
 void
 RewritingContext::markReachableNodes()
@@ -65,6 +67,12 @@ RewritingContext::makeSubcontext(DagNode* root, int /* purpose */)
   return new RewritingContext(root);
 }
 
+RewritingContext*
+RewritingContext::makeFairSubcontext(DagNode* root)
+{
+  return makeSubcontext(root, OTHER);
+}
+
 bool
 RewritingContext::handleInterrupt()
 {
@@ -68,9 +68,16 @@ public:
   //
   RewritingContext(int substitutionSize = 0);
   virtual ~RewritingContext();
-
+  //
+  //	The trace status belongs to the calling thread.
+  //
   static bool getTraceStatus();
   static void setTraceStatus(bool state);
+  //
+  //	Fair rewriting can hand the arguments of a node with many
+  //	independent stacked arguments to several threads; 1 turns this off.
+  //
+  static void setNrFairThreads(int nrThreads);
 
   DagNode* root();
   bool isLimited() const;
@@ -102,6 +109,11 @@ public:
   bool builtInReplace(DagNode* old, DagNode* replacement);
 
   virtual RewritingContext* makeSubcontext(DagNode* root, int purpose = OTHER);
+  //
+  //	Makes a context for doing fair rewriting on part of our term on
+  //	another thread; returns 0 if this isn't possible.
+  //
+  virtual RewritingContext* makeFairSubcontext(DagNode* root);
   virtual int traceBeginEqTrial(DagNode* subject, const Equation* equation);
   virtual int traceBeginRuleTrial(DagNode* subject, const Rule* rule);
   virtual int traceBeginScTrial(DagNode* subject, const SortConstraint* sc);
@@ -186,13 +198,22 @@ private:
     ROOT_OK = -2
   };
 
+  enum Parallel
+  {
+    MIN_PARALLEL_ARGUMENTS = 32	// fewest stacked arguments worth handing to threads
+  };
+
   void rebuildUptoRoot();
+  bool pathUnchanged(int redexIndex, Vector<RedexPosition>& scratch);
   void remakeStaleDagNode(int staleIndex, int childIndex);
   bool ascend();
   void descend();
   bool doRewriting(bool argsUnstackable);
+  bool parallelDescend();
+  void fairTraversalOfSubterm(bool eager, Int64 gas);
 
-  static bool traceFlag;
+  static thread_local bool traceFlag;
+  static int nrFairThreads;
 
   DagNode* rootNode;
 
@@ -213,6 +234,8 @@ private:
   Int64 gasPerNode;
   Int64 currentGas;
   int lazyMarker;
+
+  friend class ParallelFairTraversal;
 };
 
 inline
@@ -292,6 +315,12 @@ RewritingContext::setTraceStatus(bool state)
   traceFlag = state;
 }
 
+inline void
+RewritingContext::setNrFairThreads(int nrThreads)
+{
+  nrFairThreads = nrThreads;
+}
+
 inline Int64
 RewritingContext::getTotalCount() const
 {
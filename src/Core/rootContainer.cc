@@ -34,6 +34,7 @@
 #include "rootContainer.hh"
 
 RootContainer* RootContainer::listHead = 0;
+std::atomic_flag RootContainer::listLock = ATOMIC_FLAG_INIT;
 
 #ifdef DUMP
 
@@ -25,6 +25,7 @@
 //
 #ifndef _rootContainer_hh_
 #define _rootContainer_hh_
+#include <atomic>
 
 class RootContainer
 {
@@ -46,31 +47,57 @@ protected:
   virtual void markReachableNodes() = 0;
 
 private:
+  //
+  //	Root containers for all threads live on a single list so that
+  //	they can be destroyed by a different thread from the one that
+  //	created them; the list is protected by a spin lock.
+  //
+  static void lock();
+  static void unlock();
+
   static RootContainer* listHead;
+  static std::atomic_flag listLock;
 
   RootContainer* next;
   RootContainer* prev;
 };
 
+inline void
+RootContainer::lock()
+{
+  while (listLock.test_and_set(std::memory_order_acquire))
+    ;
+}
+
+inline void
+RootContainer::unlock()
+{
+  listLock.clear(std::memory_order_release);
+}
+
 inline void
 RootContainer::link()
 {
+  lock();
   prev = 0;
   next = listHead;
   if (listHead != 0)
     listHead->prev = this;
   listHead = this;
+  unlock();
 }
 
 inline void
 RootContainer::unlink()
 {
+  lock();
   if (next != 0)
     next->prev = prev;
   if (prev != 0)
     prev->next = next;
   else
     listHead = next;
+  unlock();
 }
 
 inline void
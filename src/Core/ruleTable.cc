@@ -24,6 +24,8 @@
 //      Implementation for abstract class RuleTable.
 //
 
+#include <algorithm>
+
 //	utility stuff
 #include "macros.hh"
 #include "vector.hh"
@@ -33,9 +35,11 @@
 #include "core.hh"
 
 //      interface class definitions
-//#include "symbol.hh"
-//#include "dagNode.hh"
+#include "symbol.hh"
+#include "dagNode.hh"
 #include "term.hh"
+#include "argumentIterator.hh"
+#include "dagArgumentIterator.hh"
 #include "subproblem.hh"
 #include "extensionInfo.hh"
 
@@ -44,11 +48,13 @@
 #include "lhsAutomaton.hh"
 #include "rhsAutomaton.hh"
 #include "rule.hh"
+#include "module.hh"
 #include "ruleTable.hh"
 
 RuleTable::RuleTable()
 {
   nextRule = 0;
+  indexedArgNr = NONE;
 }
 
 void
@@ -86,18 +92,153 @@ RuleTable::ruleRewrite(DagNode* subject, RewritingContext& context)
   return applyRules(subject, context, 0);
 }
 
+void
+RuleTable::indexRules(Symbol* topSymbol)
+{
+  indexedArgNr = NONE;
+  symbolToList.clear();
+  candidateLists.clear();
+  int nrRules = rules.length();
+  int nrArgs = topSymbol->arity();
+  if (nrRules < MIN_RULES_TO_INDEX || nrArgs == 0)
+    return;
+  //
+  //	For each rule, find the top symbol of each argument of its lhs
+  //	if it cannot change under instantiation, and 0 otherwise.
+  //
+  Vector<Vector<Symbol*> > argSymbols(nrRules);
+  for (int i = 0; i < nrRules; ++i)
+    {
+      Vector<Symbol*>& as = argSymbols[i];
+      as.resize(nrArgs);
+      for (Symbol*& s : as)
+	s = 0;
+      Term* lhs = rules[i]->getLhs();
+      if (lhs->symbol() == topSymbol)
+	{
+	  int j = 0;
+	  for (ArgumentIterator a(*lhs); a.valid(); a.next(), ++j)
+	    {
+	      Term* t = a.argument();
+	      if (t->stable())
+		as[j] = t->symbol();
+	    }
+	}
+    }
+  //
+  //	We choose the argument that minimizes the number of candidates
+  //	summed over one subject for each rule, taking the subject's argument
+  //	to have the same top symbol as the rule's.
+  //
+  int nrSymbols = topSymbol->getModule()->getSymbols().length();
+  Vector<int> bucketSize(nrSymbols);
+  Int64 bestCost = static_cast<Int64>(nrRules) * nrRules;
+  for (int j = 0; j < nrArgs; ++j)
+    {
+      for (int& b : bucketSize)
+	b = 0;
+      Int64 nrWildcards = 0;
+      for (int i = 0; i < nrRules; ++i)
+	{
+	  if (Symbol* s = argSymbols[i][j])
+	    ++bucketSize[s->getIndexWithinModule()];
+	  else
+	    ++nrWildcards;
+	}
+      Int64 cost = nrWildcards * nrRules;
+      for (int b : bucketSize)
+	cost += static_cast<Int64>(b) * b;
+      if (cost < bestCost)
+	{
+	  bestCost = cost;
+	  indexedArgNr = j;
+	}
+    }
+  if (indexedArgNr == NONE)
+    return;  // no argument narrows things down
+  //
+  //	Build a candidate list for each symbol that appears in the chosen
+  //	argument. Rules are added in order so each list is sorted.
+  //
+  symbolToList.resize(nrSymbols);
+  for (int& l : symbolToList)
+    l = 0;
+  candidateLists.resize(1);
+  for (int i = 0; i < nrRules; ++i)
+    {
+      if (Symbol* s = argSymbols[i][indexedArgNr])
+	{
+	  int& l = symbolToList[s->getIndexWithinModule()];
+	  if (l == 0)
+	    {
+	      l = candidateLists.size();
+	      candidateLists.resize(l + 1);
+	      candidateLists[l] = candidateLists[0];  // wildcards so far
+	    }
+	  candidateLists[l].append(i);
+	}
+      else
+	{
+	  for (Vector<int>& c : candidateLists)
+	    c.append(i);
+	}
+    }
+}
+
+DagNode*
+RuleTable::indexArgument(DagNode* subject, int argNr) const
+{
+  DagArgumentIterator a(subject);
+  for (; argNr > 0; --argNr)
+    a.next();
+  return a.argument();
+}
+
+const Vector<int>*
+RuleTable::candidateRules(DagNode* subject) const
+{
+  if (indexedArgNr == NONE)
+    return 0;
+  int index = indexArgument(subject, indexedArgNr)->symbol()->getIndexWithinModule();
+  return &(candidateLists[index < symbolToList.length() ? symbolToList[index] : 0]);
+}
+
+int
+RuleTable::nextCandidateRule(DagNode* subject, int ruleIndex) const
+{
+  const Vector<int>* candidates = candidateRules(subject);
+  if (candidates == 0)
+    return ruleIndex;
+  Vector<int>::const_iterator i = lower_bound(candidates->begin(), candidates->end(), ruleIndex);
+  return (i == candidates->end()) ? rules.length() : *i;
+}
+
 DagNode*
 RuleTable::applyRules(DagNode* subject,
 		      RewritingContext& context,
 		      ExtensionInfo* extensionInfo)
 {
   Assert(subject->getSortIndex() != Sort::SORT_UNKNOWN, "sort unknown");
+  //
+  //	If our rules are indexed we only try the candidates for subject,
+  //	but in the same round robin order, so the rule that gets applied
+  //	is the one we would have found by trying every rule.
+  //
   int nrRules = rules.length();
-  int n = nextRule;
-  for (int i = 0; i < nrRules; i++, n++)
+  int n = nextRule.load(std::memory_order_relaxed);
+  const Vector<int>* candidates = candidateRules(subject);
+  int nrCandidates = nrRules;
+  int c = n;
+  if (candidates != 0)
+    {
+      nrCandidates = candidates->length();
+      c = lower_bound(candidates->begin(), candidates->end(), n) - candidates->begin();
+    }
+  for (int i = 0; i < nrCandidates; i++, c++)
     {
-      if (n >= nrRules)
-	n = n - nrRules;
+      if (c >= nrCandidates)
+	c = c - nrCandidates;
+      n = (candidates == 0) ? c : (*candidates)[c];
       Rule* rl = rules[n];
       if (rl->isNonexec())
 	continue;
@@ -131,7 +272,7 @@ RuleTable::applyRules(DagNode* subject,
 		  context.incrementRlCount();
 		  delete sp;
 		  context.finished();
-		  nextRule = n + 1;
+		  nextRule.store(n + 1, std::memory_order_relaxed);
 		  return r;
 		}
 	    }
@@ -27,6 +27,7 @@
 #define _ruleTable_hh_
 #include <list>
 #include <stack>
+#include <atomic>
 
 class RuleTable
 {
@@ -38,6 +39,11 @@ public:
   virtual void compileRules();
   virtual DagNode* ruleRewrite(DagNode* subject, RewritingContext& context);
   virtual void resetRules();
+  //
+  //	Returns the first rule index >= ruleIndex of a rule that might
+  //	match subject, or the number of rules if there is none.
+  //
+  int nextCandidateRule(DagNode* subject, int ruleIndex) const;
   //virtual void saveHiddenState();
   //virtual void restoreHiddenState();
 
@@ -47,12 +53,43 @@ protected:
 		      RewritingContext& context,
 		      ExtensionInfo* extensionInfo);
   void resetEachRule();
+  //
+  //	Theories whose dag nodes keep their arguments in fixed positions
+  //	can call this once rules are compiled to have them indexed on the
+  //	top symbol of one argument. Rules whose lhs isn't headed by
+  //	topSymbol are tried for every subject.
+  //
+  void indexRules(Symbol* topSymbol);
+  //
+  //	Returns argument argNr of a subject headed by the topSymbol we
+  //	were indexed for; theories can override it with something faster.
+  //
+  virtual DagNode* indexArgument(DagNode* subject, int argNr) const;
 
 private:
+  enum Index
+  {
+    MIN_RULES_TO_INDEX = 8
+  };
+
+  const Vector<int>* candidateRules(DagNode* subject) const;
   //typedef stack<int, list<int> > IntStack;  // optimize for the empty case
 
   Vector<Rule*> rules;
-  int nextRule;
+  //
+  //	Fair rewriting may be applying our rules on several threads;
+  //	the exact order in which they are tried then doesn't matter
+  //	but the index must stay in range.
+  //
+  std::atomic<int> nextRule;
+  //
+  //	Rule index; candidateLists[0] holds the rules that don't constrain
+  //	the indexed argument, and the other lists also hold the rules
+  //	for one top symbol, in rule order.
+  //
+  int indexedArgNr;			// NONE if rules aren't indexed
+  Vector<int> symbolToList;		// from index within module of symbol
+  Vector<Vector<int> > candidateLists;
   //IntStack nextRuleStack;
 };
 
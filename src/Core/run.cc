@@ -23,18 +23,65 @@
 void
 RewritingContext::ruleRewrite(Int64 limit)
 {
-  Vector<RedexPosition> redexStack;
+  //
+  //	We try positions in breadth-first order and rewrite the first redex
+  //	we find. Rather than starting again from the root after each rewrite
+  //	we keep the redex stack. After a rewrite at position k, only k and
+  //	the positions on the path from k to the root hold new dag nodes; every
+  //	other position before k has been tried and marked unrewritable unless
+  //	some external agency could make it rewritable, in which case it is on
+  //	the retry list. So we try the retry list, then carry on from k. If
+  //	reducing the new root changed the shape of the path we start again
+  //	from the root.
+  //
+  Vector<RedexPosition> scratch;
+  Vector<int> retryList;
+  Vector<int> nextRetryList;
+  int nextToExplore = 0;
+  int nextToRewrite = 0;
+  int finish = 0;
+  int lastRewrite = NONE;
   for (Int64 nrRewrites = 0;; nrRewrites++)
     {
       reduce();
       if (nrRewrites == limit)
-	return;
-      redexStack.contractTo(0);
-      redexStack.append(RedexPosition(rootNode, UNDEFINED, UNDEFINED, true));
-
-      int nextToExplore = 0;
-      int finish = redexStack.length();
-      for (int nextToRewrite = 0;; nextToRewrite++)
+	break;
+      if (lastRewrite == NONE || !pathUnchanged(lastRewrite, scratch))
+	{
+	  redexStack.contractTo(0);
+	  redexStack.append(RedexPosition(rootNode, UNDEFINED, UNDEFINED, true));
+	  retryList.contractTo(0);
+	  nextToExplore = 0;
+	  nextToRewrite = 0;
+	  finish = 1;
+	}
+      //
+      //	First retry those positions before nextToRewrite that might
+      //	now be rewritable.
+      //
+      DagNode* r = 0;
+      int rewriteIndex = NONE;
+      nextRetryList.contractTo(0);
+      for (int i : retryList)
+	{
+	  if (r != 0)
+	    {
+	      nextRetryList.append(i);
+	      continue;
+	    }
+	  DagNode* d = redexStack[i].node();
+	  if (d->isUnrewritable())
+	    continue;
+	  r = d->symbol()->ruleRewrite(d, *this);
+	  if (r != 0)
+	    rewriteIndex = i;
+	  else if (!(d->isUnrewritable()))
+	    nextRetryList.append(i);
+	}
+      //
+      //	Then carry on in breadth-first order.
+      //
+      while (r == 0)
 	{
 	  if (nextToRewrite == finish)
 	    {
@@ -44,7 +91,10 @@ RewritingContext::ruleRewrite(Int64 limit)
 	      for (;;)
 		{
 		  if (nextToExplore == finish)
-		    return;
+		    {
+		      redexStack.clear();
+		      return;
+		    }
 		  DagNode* d = redexStack[nextToExplore].node();
 		  /*
 		  DebugAdvisory("Exploring " << d <<
@@ -77,32 +127,104 @@ RewritingContext::ruleRewrite(Int64 limit)
 	    }
 
 	  DagNode* d = redexStack[nextToRewrite].node();
-	  if (d->isUnrewritable())
-	    continue;
-	  DagNode* r = d->symbol()->ruleRewrite(d, *this);
-	  if (r != 0)
+	  if (!(d->isUnrewritable()))
 	    {
-	      int argIndex = redexStack[nextToRewrite].argIndex();
-	      DagNode* p = r;
-	      for (int i = redexStack[nextToRewrite].parentIndex(); i != UNDEFINED;)
+	      r = d->symbol()->ruleRewrite(d, *this);
+	      if (r != 0)
 		{
-		  RedexPosition& rp = redexStack[i];
-		  p = rp.node()->copyWithReplacement(argIndex, p);
-		  argIndex = rp.argIndex();
-		  i = rp.parentIndex();
+		  rewriteIndex = nextToRewrite;
+		  break;
 		}
-	      rootNode = p;
-	      if (traceFlag)
-		{
-		  if (traceAbort())
-		    return;
-		  tracePostRuleRewrite(r);
-		}
-	      MemoryCell::okToCollectGarbage();
-	      break;
+	      if (!(d->isUnrewritable()))
+		nextRetryList.append(nextToRewrite);
 	    }
+	  ++nextToRewrite;
+	}
+      //
+      //	Rebuild the path to the root, keeping the new dag nodes on the
+      //	stack so they will be retried.
+      //
+      redexStack[rewriteIndex].replaceNode(r);
+      int argIndex = redexStack[rewriteIndex].argIndex();
+      DagNode* p = r;
+      for (int i = redexStack[rewriteIndex].parentIndex(); i != UNDEFINED;)
+	{
+	  RedexPosition& rp = redexStack[i];
+	  p = rp.node()->copyWithReplacement(argIndex, p);
+	  rp.replaceNode(p);
+	  nextRetryList.append(i);
+	  argIndex = rp.argIndex();
+	  i = rp.parentIndex();
+	}
+      rootNode = p;
+      //
+      //	If we rewrote a position that we already explored, the stack
+      //	holds arguments of the old dag node so we must start again.
+      //
+      lastRewrite = (rewriteIndex < nextToExplore) ? NONE : rewriteIndex;
+      if (rewriteIndex < nextToRewrite)
+	nextRetryList.append(rewriteIndex);
+      sort(nextRetryList.begin(), nextRetryList.end());
+      nextRetryList.contractTo(unique(nextRetryList.begin(), nextRetryList.end()) -
+			       nextRetryList.begin());
+      retryList.swap(nextRetryList);
+      if (traceFlag)
+	{
+	  if (traceAbort())
+	    break;
+	  tracePostRuleRewrite(r);
 	}
+      MemoryCell::okToCollectGarbage();
     }
+  redexStack.clear();
+}
+
+bool
+RewritingContext::pathUnchanged(int redexIndex, Vector<RedexPosition>& scratch)
+{
+  //
+  //	Check that reducing the root didn't change the arguments of any dag
+  //	node on the path from redexIndex to the root, since the stacked
+  //	arguments must be those that stacking afresh would produce. Stacked
+  //	arguments that have since become unstackable are harmless.
+  //
+  if (redexStack[0].node() != rootNode)
+    return false;
+  for (int i = redexIndex; redexStack[i].parentIndex() != UNDEFINED;)
+    {
+      int parent = redexStack[i].parentIndex();
+      int first = i;
+      while (redexStack[first - 1].parentIndex() == parent)
+	--first;
+      int end = i + 1;
+      int length = redexStack.length();
+      while (end < length && redexStack[end].parentIndex() == parent)
+	++end;
+
+      DagNode* d = redexStack[parent].node();
+      scratch.contractTo(0);
+      d->symbol()->stackPhysicalArguments(d, scratch, parent);
+      int j = first;
+      for (const RedexPosition& rp : scratch)
+	{
+	  for (; j < end && redexStack[j].argIndex() < rp.argIndex(); ++j)
+	    {
+	      if (!(redexStack[j].node()->isUnstackable()))
+		return false;
+	    }
+	  if (j == end || redexStack[j].argIndex() != rp.argIndex() ||
+	      redexStack[j].node() != rp.node())
+	    return false;
+	  ++j;
+	}
+      for (; j < end; ++j)
+	{
+	  if (!(redexStack[j].node()->isUnstackable()))
+	    return false;
+	}
+      i = parent;
+    }
+  return true;
 }
 
 void
@@ -172,11 +294,20 @@ RewritingContext::fairTraversal()
       //
       //	Either this is our first traversal or we just completed a traversal.
       //	Either way we descend the leftmost path to start a new traveral.
+      //	If we are allowed threads and the rewrite limit and tracing can't
+      //	stop us part way through, the arguments of the first node with
+      //	enough of them may be traversed in parallel, leaving us to
+      //	carry on from that node.
       //
-      descend();
-      argsUnstackable = true;
       currentGas = gasPerNode;
       progress = false;
+      if (nrFairThreads > 1 && rewriteLimit == NONE && !traceFlag && parallelDescend())
+	argsUnstackable = ascend();
+      else
+	{
+	  descend();
+	  argsUnstackable = true;
+	}
     }
   else
     argsUnstackable = (redexStack[currentIndex].node()->symbol()->arity() == 0);
@@ -309,6 +440,64 @@ RewritingContext::descend()
     }
 }
 
+bool
+RewritingContext::parallelDescend()
+{
+  //
+  //	Like descend() but stops at the first node with more than one
+  //	stacked argument. If it has enough of them and they can be
+  //	traversed on other threads, we do so and return true with
+  //	currentIndex pointing at the last of them. Otherwise we unstack
+  //	them and return false so that descend() can carry on from the
+  //	current node.
+  //
+  if (ParallelFairTraversal::onWorkerThread())
+    return false;  // no nested parallelism
+  for (;;)
+    {
+      if (lazyMarker == NONE && !(redexStack[currentIndex].isEager()))
+	lazyMarker = currentIndex;
+      if (lazyMarker != NONE)
+	return false;  // equational rewriting below here depends on lazyMarker
+      DagNode* d = redexStack[currentIndex].node();
+      int first = redexStack.length();
+      d->symbol()->stackArguments(d, redexStack, currentIndex);
+      int nrStacked = redexStack.length() - first;
+      if (nrStacked == 1)
+	{
+	  currentIndex = first;
+	  continue;
+	}
+      if (nrStacked >= MIN_PARALLEL_ARGUMENTS)
+	{
+	  ParallelFairTraversal p(nrFairThreads);
+	  if (p.traverseArguments(*this, first))
+	    {
+	      currentIndex = redexStack.length() - 1;
+	      return true;
+	    }
+	}
+      redexStack.contractTo(first);
+      return false;
+    }
+}
+
+void
+RewritingContext::fairTraversalOfSubterm(bool eager, Int64 gas)
+{
+  //
+  //	Do one fair traversal of our root on behalf of a context that
+  //	would have traversed it as a subterm.
+  //
+  rewriteLimit = NONE;
+  gasPerNode = gas;
+  currentIndex = 0;
+  lazyMarker = NONE;
+  redexStack.clear();
+  redexStack.append(RedexPosition(rootNode, UNDEFINED, UNDEFINED, eager));
+  (void) fairTraversal();
+}
+
 bool
 RewritingContext::doRewriting(bool argsUnstackable)
 {
@@ -0,0 +1,211 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//      Implementation for class SortInfoCache.
+//
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+//	utility stuff
+#include "macros.hh"
+#include "vector.hh"
+
+//	forward declarations
+#include "interface.hh"
+#include "core.hh"
+
+//	interface class definitions
+#include "symbol.hh"
+
+//	core class definitions
+#include "module.hh"
+#include "sort.hh"
+#include "connectedComponent.hh"
+#include "sortConstraint.hh"
+#include "sortTable.hh"
+#include "sortInfoCache.hh"
+
+string SortInfoCache::directory;
+SortInfoCache* SortInfoCache::active = 0;
+
+SortInfoCache::SortInfoCache(const Module* module)
+{
+  //
+  //	The file name only needs to separate modules; the records
+  //	themselves are checked against fingerprints when used. We use the
+  //	declarations as they stand before any sort completion is done.
+  //
+  const Vector<Symbol*>& symbols = module->getSymbols();
+  Uint64 key = mix(0, symbols.size());
+  for (Symbol* s : symbols)
+    {
+      if (!(s->getOpDeclarations().empty()))
+	key = mix(key, fingerprint(s, SORT_DIAGRAMS));
+    }
+  for (SortConstraint* sc : module->getSortConstraints())
+    key = mix(key, sc->getSort()->index());
+  ostringstream name;
+  name << directory << '/' << hex << key << ".msi";
+  fileName = name.str();
+  dirty = false;
+  readFile();
+  previous = active;
+  active = this;
+}
+
+SortInfoCache::~SortInfoCache()
+{
+  active = previous;
+  if (dirty)
+    writeFile();
+}
+
+void
+SortInfoCache::setDirectory(const char* dir)
+{
+  directory = dir;
+}
+
+Uint64
+SortInfoCache::componentHash(const ConnectedComponent* component)
+{
+  pair<ComponentMap::iterator, bool> p = componentHashes.insert(ComponentMap::value_type(component, 0));
+  if (p.second)
+    {
+      //
+      //	A sort's index and the indices of the sorts below it determine
+      //	everything the sort computations look at.
+      //
+      int nrSorts = component->nrSorts();
+      Uint64 h = mix(nrSorts, component->nrMaximalSorts());
+      for (int i = 0; i < nrSorts; ++i)
+	{
+	  for (int j : component->getLeqSorts(i))
+	    h = mix(h, j);
+	  h = mix(h, NONE);
+	}
+      p.first->second = h;
+    }
+  return p.first->second;
+}
+
+Uint64
+SortInfoCache::fingerprint(const SortTable* table, RecordType type)
+{
+  const Vector<OpDeclaration>& opDeclarations = table->getOpDeclarations();
+  int nrArgs = table->arity();
+  Uint64 h = mix(type, nrArgs);
+  const Vector<Sort*>& first = opDeclarations[0].getDomainAndRange();
+  for (int i = 0; i <= nrArgs; ++i)
+    h = mix(h, componentHash(first[i]->component()));
+  for (const OpDeclaration& d : opDeclarations)
+    {
+      for (const Sort* s : d.getDomainAndRange())
+	h = mix(h, s->index());
+      h = mix(h, d.isConstructor());
+    }
+  return h;
+}
+
+const Vector<int>*
+SortInfoCache::find(Uint64 fingerprint) const
+{
+  RecordMap::const_iterator i = records.find(fingerprint);
+  return (i == records.end()) ? 0 : &(i->second);
+}
+
+void
+SortInfoCache::insert(Uint64 fingerprint, const Vector<int>& record)
+{
+  records[fingerprint] = record;
+  dirty = true;
+}
+
+void
+SortInfoCache::readFile()
+{
+  ifstream in(fileName.c_str(), ios::in | ios::binary);
+  if (!in)
+    return;  // nothing cached for this module yet
+  Int32 header[2];
+  if (!(in.read(reinterpret_cast<char*>(header), sizeof(header))) ||
+      header[0] != MAGIC || header[1] != FORMAT_VERSION)
+    return;  // not one of ours or an old format; will be overwritten
+  for (;;)
+    {
+      Uint64 fingerprint;
+      Int32 length;
+      if (!(in.read(reinterpret_cast<char*>(&fingerprint), sizeof(fingerprint))))
+	break;  // clean end of file
+      if (!(in.read(reinterpret_cast<char*>(&length), sizeof(length))) || length < 0)
+	{
+	  records.clear();  // damaged; don't trust any of it
+	  break;
+	}
+      Vector<int>& record = records[fingerprint];
+      record.resize(length);
+      if (length > 0 && !(in.read(reinterpret_cast<char*>(record.begin()), length * sizeof(Int32))))
+	{
+	  records.clear();
+	  break;
+	}
+    }
+}
+
+void
+SortInfoCache::writeFile()
+{
+  //
+  //	Another maude process may be reading or writing the same file so
+  //	we write a private temporary file and rename it into place.
+  //
+  ostringstream tempName;
+  tempName << fileName << '.' << getpid();
+  {
+    ofstream out(tempName.str().c_str(), ios::out | ios::binary | ios::trunc);
+    if (out)
+      {
+	Int32 header[2] = { MAGIC, FORMAT_VERSION };
+	out.write(reinterpret_cast<const char*>(header), sizeof(header));
+	for (const RecordMap::value_type& r : records)
+	  {
+	    Int32 length = r.second.size();
+	    out.write(reinterpret_cast<const char*>(&r.first), sizeof(r.first));
+	    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+	    out.write(reinterpret_cast<const char*>(r.second.begin()), length * sizeof(Int32));
+	  }
+	out.close();
+	if (out && rename(tempName.str().c_str(), fileName.c_str()) == 0)
+	  return;
+      }
+  }
+  (void) unlink(tempName.str().c_str());
+  static bool warned = false;
+  if (!warned)
+    {
+      IssueWarning("unable to write module cache file " << QUOTE(fileName) << '.');
+      warned = true;
+    }
+}
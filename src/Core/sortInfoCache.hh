@@ -0,0 +1,109 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	Class for a persistent cache of the sort computations done when
+//	the theory of a module is closed; namely the sort and ctor diagrams
+//	of each operator and the sort constraint dependent analyses of
+//	associative operators. These only depend on the shapes of the
+//	connected components involved and on the declarations, so records
+//	are looked up by a fingerprint of those rather than by symbol.
+//
+//	The records for a module are kept in a binary file in the cache
+//	directory, named for a hash of the module's signature. Computations
+//	that issued warnings are never recorded so that a module gives the
+//	same messages whether or not its sort information came from the cache.
+//
+#ifndef _sortInfoCache_hh_
+#define _sortInfoCache_hh_
+#include <map>
+
+class SortInfoCache
+{
+  NO_COPYING(SortInfoCache);
+
+public:
+  enum RecordType
+  {
+    SORT_DIAGRAMS,
+    ASSOCIATIVE_ANALYSIS
+  };
+  //
+  //	Makes the cache for module the active one until it is destructed,
+  //	at which point any new records are written out.
+  //
+  SortInfoCache(const Module* module);
+  ~SortInfoCache();
+
+  static void setDirectory(const char* directory);
+  static bool enabled();
+  static SortInfoCache* getActive();
+  static Uint64 mix(Uint64 hash, Uint64 value);
+
+  Uint64 fingerprint(const SortTable* table, RecordType type);
+  const Vector<int>* find(Uint64 fingerprint) const;
+  void insert(Uint64 fingerprint, const Vector<int>& record);
+
+private:
+  enum FileFormat
+  {
+    MAGIC = 0x4d534943,	// "MSIC"
+    FORMAT_VERSION = 1
+  };
+
+  typedef map<Uint64, Vector<int> > RecordMap;
+  typedef map<const ConnectedComponent*, Uint64> ComponentMap;
+
+  Uint64 componentHash(const ConnectedComponent* component);
+  void readFile();
+  void writeFile();
+
+  static string directory;
+  static SortInfoCache* active;
+
+  SortInfoCache* previous;
+  string fileName;
+  RecordMap records;
+  ComponentMap componentHashes;
+  bool dirty;
+};
+
+inline bool
+SortInfoCache::enabled()
+{
+  return !directory.empty();
+}
+
+inline SortInfoCache*
+SortInfoCache::getActive()
+{
+  return active;
+}
+
+inline Uint64
+SortInfoCache::mix(Uint64 hash, Uint64 value)
+{
+  hash = (hash ^ value) * 0x9e3779b97f4a7c15ULL;
+  return hash ^ (hash >> 29);
+}
+
+#endif
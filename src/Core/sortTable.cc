@@ -40,6 +40,7 @@
 //      core class definitions
 #include "sortBdds.hh"
 #include "sortTable.hh"
+#include "sortInfoCache.hh"
 
 #ifdef COMPILER
 #include "compilationContext.hh"
@@ -152,14 +153,82 @@ SortTable::compileOpDeclarations()
 #endif
       componentVector[i] = c;
     }
-  buildSortDiagram();
-  if (ctorStatus == IS_COMPLEX)
-    buildCtorDiagram();
+  //
+  //	Constants are cheap and not worth caching.
+  //
+  SortInfoCache* cache = (nrArgs > 0) ? SortInfoCache::getActive() : 0;
+  Uint64 fingerprint = 0;
+  if (cache != 0)
+    {
+      fingerprint = cache->fingerprint(this, SortInfoCache::SORT_DIAGRAMS);
+      const Vector<int>* record = cache->find(fingerprint);
+      if (record != 0 && restoreSortDiagrams(*record))
+	return;
+    }
+  bool clean = buildSortDiagram();
+  if (ctorStatus == IS_COMPLEX && !buildCtorDiagram())
+    clean = false;
+  if (cache != 0 && clean)
+    {
+      Vector<int> record;
+      saveSortDiagrams(record);
+      cache->insert(fingerprint, record);
+    }
 #ifdef DUMP
   // dumpSortDiagram(cout, 0);
 #endif
 }
 
+void
+SortTable::saveSortDiagrams(Vector<int>& record) const
+{
+  //
+  //	Layout is:
+  //	  singleNonErrorSort index (0 if none)
+  //	  sortDiagram length, sortDiagram entries
+  //	  ctorDiagram length, ctorDiagram entries
+  //
+  record.append(singleNonErrorSort == 0 ? 0 : singleNonErrorSort->index());
+  record.append(sortDiagram.size());
+  for (int i : sortDiagram)
+    record.append(i);
+  record.append(ctorDiagram.size());
+  for (int i : ctorDiagram)
+    record.append(i);
+}
+
+bool
+SortTable::restoreSortDiagrams(const Vector<int>& record)
+{
+  //
+  //	A record is only trusted if it is consistent with our declarations;
+  //	otherwise we leave things alone and the caller computes from scratch.
+  //
+  int recordSize = record.size();
+  if (recordSize < 3)
+    return false;
+  int singleNonErrorSortIndex = record[0];
+  if (singleNonErrorSortIndex < 0 || singleNonErrorSortIndex >= componentVector[nrArgs]->nrSorts())
+    return false;
+  int sortDiagramSize = record[1];
+  if (sortDiagramSize < componentVector[0]->nrSorts() || sortDiagramSize > recordSize - 3)
+    return false;
+  int ctorDiagramSize = record[2 + sortDiagramSize];
+  if (recordSize != 3 + sortDiagramSize + ctorDiagramSize ||
+      (ctorDiagramSize == 0) != (ctorStatus != IS_COMPLEX))
+    return false;
+
+  sortDiagram.resize(sortDiagramSize);
+  for (int i = 0; i < sortDiagramSize; ++i)
+    sortDiagram[i] = record[2 + i];
+  ctorDiagram.resize(ctorDiagramSize);
+  for (int i = 0; i < ctorDiagramSize; ++i)
+    ctorDiagram[i] = record[3 + sortDiagramSize + i];
+  singleNonErrorSort = (singleNonErrorSortIndex == 0) ? 0 :
+    componentVector[nrArgs]->sort(singleNonErrorSortIndex);
+  return true;
+}
+
 bool
 SortTable::kindLevelDeclarationsOnly() const
 {
@@ -248,7 +317,7 @@ SortTable::minimize(NatSet& alive, int argNr)
     }
 }
 
-void
+bool
 SortTable::buildSortDiagram()
 {
   Vector<NatSet> currentStates(1);
@@ -265,7 +334,7 @@ SortTable::buildSortDiagram()
 		   " do not have an unique least sort.");
       sortDiagram[0] = sortIndex;
       singleNonErrorSort = componentVector[0]->sort(sortIndex);
-      return;
+      return unique;
     }
   enum SpecialSortIndices
   {
@@ -348,9 +417,13 @@ SortTable::buildSortDiagram()
     }
   if (singleNonErrorSortIndex > 0)
     singleNonErrorSort = componentVector[nrArgs]->sort(singleNonErrorSortIndex);
-  if (!(badTerminals.empty()))
-    sortErrorAnalysis(true, badTerminals);
   DebugAdvisory("sort table for " << static_cast<Symbol*>(this) << " has " << sortDiagram.size() << " entries");
+  if (!(badTerminals.empty()))
+    {
+      sortErrorAnalysis(true, badTerminals);
+      return false;
+    }
+  return true;
 }
 
 int
@@ -93,8 +93,10 @@ private:
   struct Node;
   struct SpanningTree;
   
-  void buildSortDiagram();
-  void buildCtorDiagram();
+  bool buildSortDiagram();
+  bool buildCtorDiagram();
+  void saveSortDiagrams(Vector<int>& record) const;
+  bool restoreSortDiagrams(const Vector<int>& record);
   void sortErrorAnalysis(bool preregProblem,
 			 const set<int>& badTerminals);
   void computeMaximalOpDeclSetTable();
@@ -86,7 +86,7 @@ FreeGeneralExtor::execute(StackMachine* machine) const
       const FreeRemainder* r = *p;
       do
 	{
-	  if (r->generalCheckAndBind(binding, net.stack))
+	  if (r->generalCheckAndBind(binding, &(net.stack[0])))
 	    {
 	      frame->setNextInstruction(getNextInstruction());
 	      nextFrame->setAncestorWithValidNextInstruction(frame);
@@ -84,7 +84,7 @@ FreeGeneralExtorFinal::execute(StackMachine* machine) const
       const FreeRemainder* r = *p;
       do
 	{
-	  if (r->generalCheckAndBind(binding, net.stack))
+	  if (r->generalCheckAndBind(binding, &(net.stack[0])))
 	    {
 	      frame->setNextInstruction(r->getFirstInstruction());
 	      machine->incrementEqCount();
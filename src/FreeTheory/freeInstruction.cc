@@ -129,7 +129,7 @@ FreeInstruction::FreeInstruction(FreeSymbol* symbol, int destinationIndex, Instr
 	const FreeRemainder* r = *p;					\
 	do								\
 	  {								\
-	    if (r->fastCheckAndBind(binding, net.stack))		\
+	    if (r->fastCheckAndBind(binding, &(net.stack[0])))		\
 	      WIN();							\
 	  }								\
 	while ((r = *(++p)) != 0);					\
@@ -164,7 +164,7 @@ FreeInstruction::FreeInstruction(FreeSymbol* symbol, int destinationIndex, Instr
 	const FreeRemainder* r = *p;					\
 	do								\
 	  {								\
-	    if (r->fastCheckAndBind(binding, net.stack))		\
+	    if (r->fastCheckAndBind(binding, &(net.stack[0])))		\
 	      {								\
 		n = r->getFirstInstruction();				\
 		machine->incrementEqCount();				\
@@ -98,7 +98,7 @@ FreeLhsAutomaton::FreeLhsAutomaton(const Vector<FreeOccurrence>& freeSymbols,
 	if (symbol->arity() > 0)
 	  term->setSlotIndex(slotNr++);
       }
-    stack.expandTo(slotNr);
+    nrSlots = slotNr;
   }
   {
     //
@@ -181,14 +181,24 @@ FreeLhsAutomaton::match(DagNode* subject,
       returnedSubproblem = 0;
       return true;
     }
-  Vector<DagNode**>::iterator stackBase = stack.begin();
+  //
+  //	Our stack lives in our frame since we may be in use by several threads.
+  //
+  DagNode** localStack[LOCAL_STACK_SIZE];
+  Vector<DagNode**> bigStack;
+  DagNode*** stackBase = localStack;
+  if (nrSlots > LOCAL_STACK_SIZE)
+    {
+      bigStack.resize(nrSlots);
+      stackBase = &(bigStack[0]);
+    }
   *stackBase = static_cast<FreeDagNode*>(subject)->argArray();
   if (!freeSubterms.isNull())
     {
       //
       //	Match free symbol skeleton.
       //
-      Vector<DagNode**>::iterator stackPointer = stackBase;
+      DagNode*** stackPointer = stackBase;
       const Vector<FreeSubterm>& t = freeSubterms;
       Vector<FreeSubterm>::const_iterator i = t.begin();
       Vector<FreeSubterm>::const_iterator e = t.end();
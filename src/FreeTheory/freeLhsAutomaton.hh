@@ -60,8 +60,13 @@ private:
       int saveIndex;  // for left->right sharing
     };
 
+  enum Constants
+  {
+    LOCAL_STACK_SIZE = 16	// stack slots that match() keeps in its frame
+  };
+
   Symbol* topSymbol;
-  Vector<DagNode**> stack;
+  int nrSlots;
   Vector<FreeSubterm> freeSubterms;
   Vector<FreeVariable> uncertainVariables;
   Vector<BoundVariable> boundVariables;
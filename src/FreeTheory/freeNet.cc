@@ -72,6 +72,7 @@
 FreeNet::FreeNet()
 {
   fast = true;  // until we know otherwise
+  nrSlots = 0;
 }
 
 FreeNet::~FreeNet()
@@ -131,6 +132,7 @@ FreeNet::addRemainderList(const PatternSet& liveSet)
 void
 FreeNet::translateSlots(int nrRealSlots, const Vector<int>& slotTranslation)
 {
+  nrSlots = nrRealSlots;
   stack.expandTo(nrRealSlots);
   int nrNodes = net.length();
   for (int i = 0; i < nrNodes; i++)
@@ -133,7 +133,13 @@ private:
   bool applyReplaceFast2(DagNode* subject, RewritingContext& context);
   bool applyReplaceNoOwise2(DagNode* subject, RewritingContext& context);
 
-  Vector<DagNode**> stack;
+  enum Constants
+  {
+    LOCAL_STACK_SIZE = 16	// stack slots that applyReplace*2() keep in their frame
+  };
+
+  int nrSlots;
+  Vector<DagNode**> stack;	// only used for stack machine execution
   Vector<TestNode> net;
   Vector<Vector<FreeRemainder*> > fastApplicable;
   Vector<FreeRemainder*> remainders;
@@ -35,13 +35,25 @@ FreeNet::applyReplace2(DagNode* subject, RewritingContext& context)
   //	(actually remainder pointers) which match the free symbol skeleton in the
   //	subject.
   //
+  //
+  //	The stack lives in our own frame so that we can be reentered, by
+  //	rewriting done to check a condition or by another thread.
+  //
+  DagNode** localStack[LOCAL_STACK_SIZE];
+  Vector<DagNode**> bigStack;
+  DagNode*** stack = localStack;
+  if (nrSlots > LOCAL_STACK_SIZE)
+    {
+      bigStack.resize(nrSlots);
+      stack = &(bigStack[0]);
+    }
   long i;
   if (!(net.isNull()))  // at least one pattern has free symbols
     {
       DagNode** topArgArray = static_cast<FreeDagNode*>(subject)->argArray();
       Vector<TestNode>::const_iterator netBase = net.begin();
       Vector<TestNode>::const_iterator n = netBase;
-      Vector<DagNode**>::iterator stackBase = stack.begin();
+      DagNode*** stackBase = stack;
       DagNode* d = topArgArray[n->argIndex];
       int symbolIndex = d->symbol()->getIndexWithinModule();
       stack[0] = topArgArray;
@@ -107,6 +119,14 @@ FreeNet::applyReplaceFast2(DagNode* subject, RewritingContext& context)
   //	Optimized version of the the above that only works for unary,
   //	binary and ternary top symbols.
   //
+  DagNode** localStack[LOCAL_STACK_SIZE];
+  Vector<DagNode**> bigStack;
+  DagNode*** stack = localStack;
+  if (nrSlots > LOCAL_STACK_SIZE)
+    {
+      bigStack.resize(nrSlots);
+      stack = &(bigStack[0]);
+    }
   long i;
   DagNode** topArgArray = static_cast<FreeDagNode*>(subject)->internal;
   stack[0] = topArgArray;
@@ -114,7 +134,7 @@ FreeNet::applyReplaceFast2(DagNode* subject, RewritingContext& context)
     {
       Vector<TestNode>::const_iterator netBase = net.begin();
       Vector<TestNode>::const_iterator n = netBase;
-      Vector<DagNode**>::iterator stackBase = stack.begin();
+      DagNode*** stackBase = stack;
       DagNode* d = topArgArray[n->argIndex];
       int symbolIndex = d->symbol()->getIndexWithinModule();
       for (;;)
@@ -176,13 +196,21 @@ FreeNet::applyReplaceNoOwise2(DagNode* subject, RewritingContext& context)
   //	(actually remainder pointers) which match the free symbol skeleton in the
   //	subject.
   //
+  DagNode** localStack[LOCAL_STACK_SIZE];
+  Vector<DagNode**> bigStack;
+  DagNode*** stack = localStack;
+  if (nrSlots > LOCAL_STACK_SIZE)
+    {
+      bigStack.resize(nrSlots);
+      stack = &(bigStack[0]);
+    }
   long i;
   if (!(net.isNull()))  // at least one pattern has free symbols
     {
       DagNode** topArgArray = static_cast<FreeDagNode*>(subject)->argArray();
       Vector<TestNode>::const_iterator netBase = net.begin();
       Vector<TestNode>::const_iterator n = netBase;
-      Vector<DagNode**>::iterator stackBase = stack.begin();
+      DagNode*** stackBase = stack;
       DagNode* d = topArgArray[n->argIndex];
       int symbolIndex = d->symbol()->getIndexWithinModule();
       stack[0] = topArgArray;
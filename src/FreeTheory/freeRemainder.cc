@@ -209,7 +209,7 @@ FreeRemainder::~FreeRemainder()
 local_inline bool 
 FreeRemainder::slowMatchReplace2(DagNode* subject,
 				 RewritingContext& context,
-				 Vector<DagNode**>& stack) const
+				 DagNode** const* stackBase) const
 {
   Subproblem* subproblem = 0;  // need to zero subproblem here since later code may not initialize it
   if (foreign)
@@ -224,7 +224,6 @@ FreeRemainder::slowMatchReplace2(DagNode* subject,
     }
   else
     {
-      Vector<DagNode**>::const_iterator stackBase = stack.begin();
       //
       //	Bind free variables
       //
@@ -303,14 +302,11 @@ FreeRemainder::slowMatchReplace2(DagNode* subject,
   if (equation->hasCondition())
     {
       //
-      //	The rewriting we do to evaluate our condition may well overwrite
-      //	the stack; but the stack must be preserved to allow us to handle
-      //	the next remainder if the condition fails or rewriting is aborted.
+      //	The stack belongs to our caller's stack frame so the rewriting
+      //	we do to evaluate our condition cannot overwrite it; it is still
+      //	intact if we need to handle the next remainder.
       //
-      Vector<DagNode**> savedStack(stack.size());
-      savedStack.swap(stack);  // save by swapping is safe since we no longer keep pointer to stack elements
       bool r = equation->checkCondition(subject, context, subproblem);
-      savedStack.swap(stack);
       if (!r)
 	{
 	  delete subproblem;
@@ -343,23 +339,22 @@ FreeRemainder::slowMatchReplace2(DagNode* subject,
 bool 
 FreeRemainder::slowMatchReplace(DagNode* subject,
 				RewritingContext& context,
-				Vector<DagNode**>& stack) const
+				DagNode** const* stackBase) const
 {
   context.clear(equation->getNrProtectedVariables());
-  bool r = slowMatchReplace2(subject, context, stack);
+  bool r = slowMatchReplace2(subject, context, stackBase);
   context.finished();
   MemoryCell::okToCollectGarbage();
   return r;
 }
 
 bool
-FreeRemainder::slowCheckAndBind(DagNode** binding, Vector<DagNode**>& stack) const
+FreeRemainder::slowCheckAndBind(DagNode** binding, DagNode** const* stackBase) const
 {
   //
   //	Eventually we want to add a condition stack to the stack machine and take the stack
   //	machine reference as an arguement. For the moment we only handle simple stuff.
   //
-  Vector<DagNode**>::const_iterator stackBase = stack.begin();
   //
   //	Bind free variables
   //
@@ -50,18 +50,18 @@ public:
 
   bool fastMatchReplace(DagNode* subject,
 			RewritingContext& context,
-			Vector<DagNode**>& stack) const;
+			DagNode** const* stackBase) const;
   bool slowMatchReplace(DagNode* subject,
 			RewritingContext& context,
-			Vector<DagNode**>& stack) const;
+			DagNode** const* stackBase) const;
 
   bool isOwise() const;
   //
   //	Stuff for stack machine execution
   //
-  bool fastCheckAndBind(DagNode** binding, Vector<DagNode**>& stack) const;
-  bool generalCheckAndBind(DagNode** binding, Vector<DagNode**>& stack) const;
-  bool slowCheckAndBind(DagNode** binding, Vector<DagNode**>& stack) const;
+  bool fastCheckAndBind(DagNode** binding, DagNode** const* stackBase) const;
+  bool generalCheckAndBind(DagNode** binding, DagNode** const* stackBase) const;
+  bool slowCheckAndBind(DagNode** binding, DagNode** const* stackBase) const;
   Instruction* getFirstInstruction() const;
   bool fastHandling() const;
   
@@ -72,7 +72,7 @@ public:
 private:
   bool slowMatchReplace2(DagNode* subject,
 			RewritingContext& context,
-			Vector<DagNode**>& stack) const;
+			DagNode** const* stackBase) const;
   //
   //	To qualify for "fast" treatment the associated equation must:
   //	(1) have a lhs that parses into a non-error sort
@@ -105,13 +105,12 @@ FreeRemainder::fastHandling() const
 inline bool 
 FreeRemainder::fastMatchReplace(DagNode* subject,
 				RewritingContext& context,
-				Vector<DagNode**>& stack) const
+				DagNode** const* stackBase) const
 {
   if (!(RewritingContext::getTraceStatus()))
     {
       if (fast > 0)
 	{
-	  Vector<DagNode**>::const_iterator stackBase = stack.begin();
 	  FOR_EACH_CONST(i, Vector<FreeVariable>, freeVariables)
 	    {
 	      DagNode* d = stackBase[i->position][i->argIndex];
@@ -121,7 +120,6 @@ FreeRemainder::fastMatchReplace(DagNode* subject,
 	}
       else if (fast < 0)
 	{
-	  Vector<DagNode**>::const_iterator stackBase = stack.begin();
 	  FOR_EACH_CONST(i, Vector<FreeVariable>, freeVariables)
 	    {
 	      DagNode* d = stackBase[i->position][i->argIndex];
@@ -140,7 +138,7 @@ FreeRemainder::fastMatchReplace(DagNode* subject,
       return true;
     }
 slow:
-  return slowMatchReplace(subject, context, stack);
+  return slowMatchReplace(subject, context, stackBase);
 }
 
 inline bool
@@ -150,12 +148,11 @@ FreeRemainder::isOwise() const
 }
 
 inline bool
-FreeRemainder::fastCheckAndBind(DagNode** binding, Vector<DagNode**>& stack) const
+FreeRemainder::fastCheckAndBind(DagNode** binding, DagNode** const* stackBase) const
 {
   //
   //	We only handle the "super-fast" and "fast" cases.
   //
-  Vector<DagNode**>::const_iterator stackBase = stack.begin();
   if (fast > 0)
     {
       //
@@ -189,7 +186,7 @@ FreeRemainder::fastCheckAndBind(DagNode** binding, Vector<DagNode**>& stack) con
 }
 
 inline bool
-FreeRemainder::generalCheckAndBind(DagNode** binding, Vector<DagNode**>& stack) const
+FreeRemainder::generalCheckAndBind(DagNode** binding, DagNode** const* stackBase) const
 {
   //
   //	Just like fastCheckAndBind() except that it calls slowCheckAndBind()
@@ -198,7 +195,6 @@ FreeRemainder::generalCheckAndBind(DagNode** binding, Vector<DagNode**>& stack)
   //	undesirable in tight code where fast-ness has already been determined,
   //	hence the existence of fastCheckAndBind().
   //
-  Vector<DagNode**>::const_iterator stackBase = stack.begin();
   if (fast > 0)
     {
       //
@@ -233,7 +229,7 @@ FreeRemainder::generalCheckAndBind(DagNode** binding, Vector<DagNode**>& stack)
       //	Remainder is neither "super-fast" nor "fast". Call out-lined code to
       //	do the most general thing.
       //
-      return slowCheckAndBind(binding, stack);
+      return slowCheckAndBind(binding, stackBase);
     }
   return true;
 }
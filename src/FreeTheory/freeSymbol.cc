@@ -132,6 +132,19 @@ FreeSymbol::compileEquations()
   n.semiCompile(discriminationNet);
 }
 
+void
+FreeSymbol::compileRules()
+{
+  Symbol::compileRules();
+  indexRules(this);
+}
+
+DagNode*
+FreeSymbol::indexArgument(DagNode* subject, int argNr) const
+{
+  return safeCast(FreeDagNode*, subject)->argArray()[argNr];
+}
+
 Term*
 FreeSymbol::makeTerm(const Vector<Term*>& args)
 {
@@ -202,6 +215,7 @@ FreeSymbol::complexStrategy(DagNode* subject, RewritingContext& context)
 	  --a;  // real arguments start at 0 not 1
 	  if (seenZero)
 	    {
+	      MemoryCell::writeBarrier(subject);
 	      args[a] = args[a]->copyReducible();
 	      //
 	      //	A previous call to discriminationNet.applyReplace() may have
@@ -254,6 +268,7 @@ FreeSymbol::memoStrategy(MemoTable::SourceSet& from,
 	  --a;  // real arguments start at 0 not 1
 	  if (seenZero)
 	    {
+	      MemoryCell::writeBarrier(subject);
 	      args[a] = args[a]->copyReducible();
 	      //
 	      //	A previous call to discriminationNet.applyReplace() may have
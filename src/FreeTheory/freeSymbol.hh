@@ -46,6 +46,7 @@ public:
   Term* makeTerm(const Vector<Term*>& args);
   DagNode* makeDagNode(const Vector<DagNode*>& args);
   void compileEquations();
+  void compileRules();
   bool eqRewrite(DagNode* subject, RewritingContext& context);
   void computeBaseSort(DagNode* subject);
   void normalizeAndComputeTrueSort(DagNode* subject, RewritingContext& context);
@@ -89,6 +90,9 @@ public:
   void dump(ostream& s, int indentLevel = 0);
 #endif
 
+protected:
+  DagNode* indexArgument(DagNode* subject, int argNr) const;
+
 private:
   bool complexStrategy(DagNode* subject, RewritingContext& context);
   void memoStrategy(MemoTable::SourceSet& from, DagNode* subject, RewritingContext& context);
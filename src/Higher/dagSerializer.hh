@@ -0,0 +1,49 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	Abstract base class for objects that can flatten a dag into a
+//	character sequence and rebuild it again, so that dags can be moved
+//	between processes.
+//
+#ifndef _dagSerializer_hh_
+#define _dagSerializer_hh_
+#include "rope.hh"
+
+class DagSerializer
+{
+public:
+  virtual ~DagSerializer() {}
+
+  virtual Rope serialize(DagNode* dagNode) = 0;
+  virtual DagNode* deserialize(const Rope& encoding) = 0;
+  //
+  //	Serializers that can decode straight from a contiguous buffer
+  //	should override this to avoid building a Rope.
+  //
+  virtual DagNode* deserialize(const char* data, size_t length)
+  {
+    return deserialize(Rope(data, length));
+  }
+};
+
+#endif
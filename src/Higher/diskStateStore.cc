@@ -0,0 +1,244 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+
+//
+//	Implementation for class DiskStateStore.
+//
+#include <string.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+//	utility stuff
+#include "macros.hh"
+#include "vector.hh"
+
+//	forward declarations
+#include "interface.hh"
+#include "core.hh"
+#include "higher.hh"
+
+//	interface class definitions
+#include "dagNode.hh"
+
+//	core class definitions
+#include "hashConsSet.hh"
+
+//	higher class definitions
+#include "dagSerializer.hh"
+#include "diskStateStore.hh"
+
+DiskStateStore::DiskStateStore(DagSerializer* serializer)
+  : serializer(serializer)
+{
+  fd = -1;
+  base = 0;
+  mappedSize = 0;
+  logEnd = 0;
+}
+
+DiskStateStore::~DiskStateStore()
+{
+  if (base != 0)
+    munmap(base, mappedSize);
+  if (fd != -1)
+    close(fd);
+}
+
+bool
+DiskStateStore::open(const char* directory)
+{
+  string path(directory);
+  path += "/maude-states-XXXXXX";
+  fd = mkstemp(&path[0]);
+  if (fd == -1)
+    return false;
+  //
+  //	The file will disappear once we close it, or if we die.
+  //
+  unlink(path.c_str());
+  if (!remap(INITIAL_FILE_SIZE))
+    {
+      int savedErrno = errno;
+      close(fd);
+      fd = -1;
+      errno = savedErrno;
+      return false;
+    }
+  table.resize(INITIAL_TABLE_SIZE);
+  for (int& i : table)
+    i = NONE;
+  return true;
+}
+
+int
+DiskStateStore::insert(DagNode* dagNode, bool& isNew)
+{
+  //
+  //	Serialization follows pointers so two equal dags only have the same
+  //	encoding if their sharing is the same; we hash cons a copy to
+  //	get maximal sharing.
+  //
+  Rope encoding;
+  {
+    HashConsSet canonicalizer;
+    encoding = serializer->serialize(canonicalizer.getCanonical(canonicalizer.insert(dagNode)));
+  }
+  size_t length = encoding.length();
+  buffer.resize(length);
+  encoding.copy(&buffer[0]);
+  Uint64 f = fingerprint(buffer.data(), length);
+  int slot = findSlot(f, buffer.data(), length);
+  if (table[slot] != NONE)
+    {
+      isNew = false;
+      return table[slot];
+    }
+
+  Int64 offset;
+  if (!append(buffer.data(), length, offset))
+    {
+      IssueWarning("unable to extend state store: " << strerror(errno));
+      exit(EXIT_FAILURE);
+    }
+  int index = records.size();
+  records.expandBy(1);
+  Record& r = records[index];
+  r.fingerprint = f;
+  r.offset = offset;
+  table[slot] = index;
+  if (2 * records.size() > table.size())
+    resizeTable();
+  isNew = true;
+  return index;
+}
+
+DagNode*
+DiskStateStore::fetch(int index) const
+{
+  const char* p = base + records[index].offset;
+  Length length;
+  memcpy(&length, p, sizeof(Length));
+  return serializer->deserialize(p + sizeof(Length), length);
+}
+
+size_t
+DiskStateStore::getNrBytesInMemory() const
+{
+  return records.length() * sizeof(Record) + table.length() * sizeof(int);
+}
+
+Uint64
+DiskStateStore::fingerprint(const char* data, size_t length)
+{
+  //
+  //	64-bit FNV-1a.
+  //
+  Uint64 hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < length; ++i)
+    {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= 0x100000001b3ULL;
+    }
+  return hash;
+}
+
+bool
+DiskStateStore::append(const char* data, Length length, Int64& offset)
+{
+  size_t needed = logEnd + sizeof(Length) + length;
+  if (needed > mappedSize)
+    {
+      size_t newSize = 2 * mappedSize;
+      while (newSize < needed)
+	newSize *= 2;
+      if (!remap(newSize))
+	return false;
+    }
+  offset = logEnd;
+  memcpy(base + logEnd, &length, sizeof(Length));
+  memcpy(base + logEnd + sizeof(Length), data, length);
+  logEnd = needed;
+  return true;
+}
+
+bool
+DiskStateStore::remap(size_t newSize)
+{
+  if (ftruncate(fd, newSize) == -1)
+    return false;
+  void* p = mmap(0, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (p == MAP_FAILED)
+    return false;
+  if (base != 0)
+    munmap(base, mappedSize);
+  base = static_cast<char*>(p);
+  mappedSize = newSize;
+  return true;
+}
+
+bool
+DiskStateStore::sameEncoding(int index, const char* data, size_t length) const
+{
+  const char* p = base + records[index].offset;
+  Length storedLength;
+  memcpy(&storedLength, p, sizeof(Length));
+  return storedLength == length && memcmp(p + sizeof(Length), data, length) == 0;
+}
+
+int
+DiskStateStore::findSlot(Uint64 fingerprint, const char* data, size_t length) const
+{
+  //
+  //	Returns the slot holding the record with the given encoding, or the
+  //	empty slot where it should go. Only when fingerprints agree do we
+  //	need to look at the log.
+  //
+  int mask = table.size() - 1;
+  for (int i = fingerprint & mask;; i = (i + 1) & mask)
+    {
+      int index = table[i];
+      if (index == NONE ||
+	  (records[index].fingerprint == fingerprint && sameEncoding(index, data, length)))
+	return i;
+    }
+}
+
+void
+DiskStateStore::resizeTable()
+{
+  int newSize = 2 * table.size();
+  table.resize(newSize);
+  for (int& i : table)
+    i = NONE;
+  int nrRecords = records.size();
+  int mask = newSize - 1;
+  for (int i = 0; i < nrRecords; ++i)
+    {
+      int j = records[i].fingerprint & mask;
+      while (table[j] != NONE)
+	j = (j + 1) & mask;
+      table[j] = i;
+    }
+}
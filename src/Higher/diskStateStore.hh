@@ -0,0 +1,107 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+
+//
+//	Class for storing the state dags of a StateTransitionGraph on disk.
+//
+//	Each new state dag is serialized, after hash consing so that equal
+//	dags always have the same encoding, and appended to a log file that
+//	is memory mapped and unlinked as soon as it is created. Only a
+//	fingerprint and a file offset are kept in memory for each state; a
+//	state dag is rebuilt from its encoding when it is needed again.
+//
+#ifndef _diskStateStore_hh_
+#define _diskStateStore_hh_
+
+class DiskStateStore
+{
+  NO_COPYING(DiskStateStore);
+
+public:
+  DiskStateStore(DagSerializer* serializer);
+  ~DiskStateStore();
+  //
+  //	Create the log file in directory; returns false with errno set if
+  //	we couldn't.
+  //
+  bool open(const char* directory);
+  //
+  //	Returns the index of dagNode's record, adding a new record if
+  //	we haven't seen dagNode before.
+  //
+  int insert(DagNode* dagNode, bool& isNew);
+  //
+  //	Returns a fresh unreduced copy of the dag stored in a record.
+  //
+  DagNode* fetch(int index) const;
+
+  int getNrRecords() const;
+  size_t getNrBytesInMemory() const;
+  size_t getNrBytesOnDisk() const;
+
+private:
+  enum Parameters
+  {
+    INITIAL_FILE_SIZE = 1024 * 1024,
+    INITIAL_TABLE_SIZE = 1024		// must be a power of 2
+  };
+
+  typedef Uint32 Length;
+
+  struct Record
+  {
+    Uint64 fingerprint;
+    Int64 offset;			// offset of length in log
+  };
+
+  static Uint64 fingerprint(const char* data, size_t length);
+
+  bool append(const char* data, Length length, Int64& offset);
+  bool remap(size_t newSize);
+  bool sameEncoding(int index, const char* data, size_t length) const;
+  int findSlot(Uint64 fingerprint, const char* data, size_t length) const;
+  void resizeTable();
+
+  DagSerializer* const serializer;
+  int fd;
+  char* base;			// start of mapped log
+  size_t mappedSize;
+  size_t logEnd;
+  Vector<Record> records;
+  Vector<int> table;		// open addressing hash table of record indices
+  string buffer;		// scratch space for encodings
+};
+
+inline int
+DiskStateStore::getNrRecords() const
+{
+  return records.size();
+}
+
+inline size_t
+DiskStateStore::getNrBytesOnDisk() const
+{
+  return logEnd;
+}
+
+#endif
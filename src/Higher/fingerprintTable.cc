@@ -0,0 +1,224 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+
+//
+//	Implementation for class FingerprintTable.
+//
+#include <math.h>
+
+//	utility stuff
+#include "macros.hh"
+#include "vector.hh"
+
+//	forward declarations
+#include "interface.hh"
+#include "core.hh"
+#include "higher.hh"
+
+//	interface class definitions
+#include "symbol.hh"
+#include "dagNode.hh"
+
+//	core class definitions
+#include "dagArgumentIterator.hh"
+
+//	higher class definitions
+#include "fingerprintTable.hh"
+
+FingerprintTable::FingerprintTable()
+{
+  table.resize(INITIAL_TABLE_SIZE);
+  for (Entry& e : table)
+    e.fingerprint = 0;
+  nrEntries = 0;
+  bitMask = 0;
+  nrHashFunctions = 0;
+  nrBitsSet = 0;
+  firstFingerprint = 0;
+  expectedOmissions = 0.0;
+}
+
+FingerprintTable::FingerprintTable(int log2NrBits, int nrHashFunctions)
+  : nrHashFunctions(nrHashFunctions)
+{
+  Uint64 nrBits = static_cast<Uint64>(1) << log2NrBits;
+  bits.resize((nrBits + 63) / 64);
+  for (Uint64& w : bits)
+    w = 0;
+  bitMask = nrBits - 1;
+  nrEntries = 0;
+  nrBitsSet = 0;
+  firstFingerprint = 0;
+  expectedOmissions = 0.0;
+}
+
+int
+FingerprintTable::insert(Uint64 fingerprint, int stateNr)
+{
+  if (fingerprint == 0)
+    fingerprint = 1;  // 0 is reserved for empty slots
+  return bits.empty() ? compactionInsert(fingerprint, stateNr) : bitstateInsert(fingerprint, stateNr);
+}
+
+double
+FingerprintTable::getOmissionProbability() const
+{
+  return -expm1(-expectedOmissions);
+}
+
+size_t
+FingerprintTable::getNrBytesUsed() const
+{
+  return table.length() * sizeof(Entry) + bits.length() * sizeof(Uint64);
+}
+
+Uint64
+FingerprintTable::fingerprint(DagNode* dagNode)
+{
+  FingerprintMap memo;
+  return fingerprint(dagNode, memo);
+}
+
+Uint64
+FingerprintTable::mix(Uint64 x)
+{
+  //
+  //	splitmix64 finalizer.
+  //
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+Uint64
+FingerprintTable::fingerprint(DagNode* dagNode, FingerprintMap& memo)
+{
+  //
+  //	getHashValue() is designed for hash tables and makes a poor 64-bit
+  //	fingerprint on its own, but it takes account of the data held in
+  //	built-in dag nodes. So we start with it and strengthen it by mixing
+  //	in the fingerprints of the arguments, in order.
+  //
+  if (dagNode->symbol()->arity() > 0)
+    {
+      FingerprintMap::const_iterator i = memo.find(dagNode);
+      if (i != memo.end())
+	return i->second;
+    }
+  Uint64 f = mix(dagNode->getHashValue() + 0x9e3779b97f4a7c15ULL);
+  for (DagArgumentIterator a(*dagNode); a.valid(); a.next())
+    f = mix(f ^ (fingerprint(a.argument(), memo) + 0x9e3779b97f4a7c15ULL));
+  if (dagNode->symbol()->arity() > 0)
+    memo[dagNode] = f;
+  return f;
+}
+
+int
+FingerprintTable::compactionInsert(Uint64 fingerprint, int stateNr)
+{
+  int mask = table.size() - 1;
+  int i = fingerprint & mask;
+  for (; table[i].fingerprint != 0; i = (i + 1) & mask)
+    {
+      if (table[i].fingerprint == fingerprint)
+	return table[i].stateNr;
+    }
+  //
+  //	A new state could have been lost by colliding with any of the
+  //	fingerprints we already have.
+  //
+  expectedOmissions += ldexp(nrEntries, -64);
+  table[i].fingerprint = fingerprint;
+  table[i].stateNr = stateNr;
+  ++nrEntries;
+  if (2 * nrEntries > table.length())
+    resizeTable();
+  return stateNr;
+}
+
+int
+FingerprintTable::bitstateInsert(Uint64 fingerprint, int stateNr)
+{
+  //
+  //	We use double hashing to get nrHashFunctions bit indices.
+  //
+  Uint64 step = mix(fingerprint) | 1;
+  bool seen = true;
+  Uint64 h = fingerprint;
+  for (int i = 0; i < nrHashFunctions; ++i, h += step)
+    {
+      Uint64 index = h & bitMask;
+      Uint64& word = bits[index / 64];
+      Uint64 bit = static_cast<Uint64>(1) << (index % 64);
+      if ((word & bit) == 0)
+	seen = false;
+    }
+  if (seen)
+    return (fingerprint == firstFingerprint) ? 0 : UNKNOWN;
+  //
+  //	A new state could have been lost if all its bits had already been
+  //	set by other states.
+  //
+  expectedOmissions += pow(static_cast<double>(nrBitsSet) / (bitMask + 1.0), nrHashFunctions);
+  h = fingerprint;
+  for (int i = 0; i < nrHashFunctions; ++i, h += step)
+    {
+      Uint64 index = h & bitMask;
+      Uint64& word = bits[index / 64];
+      Uint64 bit = static_cast<Uint64>(1) << (index % 64);
+      if ((word & bit) == 0)
+	{
+	  word |= bit;
+	  ++nrBitsSet;
+	}
+    }
+  if (nrEntries == 0)
+    firstFingerprint = fingerprint;
+  ++nrEntries;
+  return stateNr;
+}
+
+void
+FingerprintTable::resizeTable()
+{
+  Vector<Entry> oldTable;
+  oldTable.swap(table);
+  int newSize = 2 * oldTable.size();
+  table.resize(newSize);
+  for (Entry& e : table)
+    e.fingerprint = 0;
+  int mask = newSize - 1;
+  for (const Entry& e : oldTable)
+    {
+      if (e.fingerprint != 0)
+	{
+	  int i = e.fingerprint & mask;
+	  while (table[i].fingerprint != 0)
+	    i = (i + 1) & mask;
+	  table[i] = e;
+	}
+    }
+}
@@ -0,0 +1,102 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+
+//
+//	Class for identifying states by hashing rather than by keeping them.
+//
+//	In hash compaction mode we keep a 64-bit fingerprint for each state
+//	and two states with the same fingerprint are identified. In bitstate
+//	mode (Holzmann's supertrace) each state sets k bits in a large bit
+//	array and a state whose bits are all set is assumed to have been
+//	seen before; we no longer know which state it was. Either way,
+//	distinct states can be confused, so some states may be omitted from
+//	the search; we keep a running estimate of the chance of this.
+//
+#ifndef _fingerprintTable_hh_
+#define _fingerprintTable_hh_
+#include <map>
+
+class FingerprintTable
+{
+  NO_COPYING(FingerprintTable);
+
+public:
+  enum Values
+  {
+    UNKNOWN = -2	// seen before but we don't know which state it was
+  };
+
+  FingerprintTable();				// hash compaction
+  FingerprintTable(int log2NrBits, int nrHashFunctions);	// bitstate
+  //
+  //	If fingerprint is new, record it as belonging to stateNr and
+  //	return stateNr. Otherwise return the state it belongs to, or UNKNOWN
+  //	in bitstate mode, where only the first state is remembered.
+  //
+  int insert(Uint64 fingerprint, int stateNr);
+  double getOmissionProbability() const;
+  size_t getNrBytesUsed() const;
+
+  static Uint64 fingerprint(DagNode* dagNode);
+
+private:
+  enum Parameters
+  {
+    INITIAL_TABLE_SIZE = 1024		// must be a power of 2
+  };
+
+  struct Entry
+  {
+    Uint64 fingerprint;		// 0 means empty
+    int stateNr;
+  };
+
+  typedef map<DagNode*, Uint64> FingerprintMap;
+
+  static Uint64 mix(Uint64 x);
+  static Uint64 fingerprint(DagNode* dagNode, FingerprintMap& memo);
+
+  int compactionInsert(Uint64 fingerprint, int stateNr);
+  int bitstateInsert(Uint64 fingerprint, int stateNr);
+  void resizeTable();
+  //
+  //	Hash compaction.
+  //
+  Vector<Entry> table;
+  int nrEntries;
+  //
+  //	Bitstate.
+  //
+  Vector<Uint64> bits;
+  Uint64 bitMask;
+  int nrHashFunctions;
+  Uint64 nrBitsSet;
+  Uint64 firstFingerprint;	// so we can recognize the initial state
+  //
+  //	Sum over all new states of the probability that it was wrongly
+  //	thought to have been seen.
+  //
+  double expectedOmissions;
+};
+
+#endif
@@ -38,6 +38,10 @@ class RewriteSequenceSearch;
 
 class StateTransitionGraph3;
 class StateTransitionGraph;
+class StateExpansionPool;
+class DiskStateStore;
+class FingerprintTable;
+class DagSerializer;
 
 class EqualityConditionFragment;
 class SortTestConditionFragment;
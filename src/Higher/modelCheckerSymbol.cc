@@ -64,6 +64,8 @@
 //      higher class definitions
 #include "modelCheckerSymbol.hh"
 
+int ModelCheckerSymbol::nrProcesses = 1;
+
 ModelCheckerSymbol::ModelCheckerSymbol(int id)
   : TemporalSymbol(id, 2)
 {
@@ -225,12 +227,21 @@ ModelCheckerSymbol::makeTransitionList(const StateTransitionGraph& states,
 
 DagNode*
 ModelCheckerSymbol::makeCounterexample(const StateTransitionGraph& states,
-				       const ModelChecker2& mc)
+				       const list<int>& leadIn,
+				       const list<int>& cycle)
 {
+  //
+  //	Building the counterexample must not garbage collect.
+  //
+  for (int stateNr : leadIn)
+    states.prefetchState(stateNr);
+  for (int stateNr : cycle)
+    states.prefetchState(stateNr);
+
   Vector<DagNode*> args(2);
-  int junction = mc.getCycle().front();
-  args[0] = makeTransitionList(states, mc.getLeadIn(), junction);
-  args[1] = makeTransitionList(states, mc.getCycle(), junction);
+  int junction = cycle.front();
+  args[0] = makeTransitionList(states, leadIn, junction);
+  args[1] = makeTransitionList(states, cycle, junction);
   return counterexampleSymbol->makeDagNode(args);
 }
 
@@ -265,27 +276,51 @@ ModelCheckerSymbol::eqRewrite(DagNode* subject, RewritingContext& context)
   formula.dump(cout);
 #endif
   //
-  //	Do the model check using a ModelChecker2 object.
+  //	Do the model check using a ModelChecker2 object, or a
+  //	SwarmModelChecker object if we have been asked to use several
+  //	processes and nothing needs to see individual rewrites.
   //
   system.satisfiesSymbol = satisfiesSymbol;
   system.parentContext = &context;
   system.trueTerm = trueTerm.getDag();
   RewritingContext* sysContext = context.makeSubcontext(d->getArgument(0));
   system.systemStates = new StateTransitionGraph(sysContext);
-  ModelChecker2 mc(system, formula, top);
-  bool result = mc.findCounterexample();
+  system.systemStates->useStateHashing(true);
+  system.systemStates->useStateStore();
+  bool result;
+  list<int> leadIn;
+  list<int> cycle;
+  if (nrProcesses > 1 && !RewritingContext::getTraceStatus())
+    {
+      SwarmModelChecker mc(system, formula, top, nrProcesses);
+      result = mc.findCounterexample();
+      leadIn = mc.getLeadIn();
+      cycle = mc.getCycle();
+    }
+  else
+    {
+      ModelChecker2 mc(system, formula, top);
+      result = mc.findCounterexample();
+      leadIn = mc.getLeadIn();
+      cycle = mc.getCycle();
+    }
   int nrSystemStates = system.systemStates->getNrStates();
   Verbose("ModelCheckerSymbol: Examined " << nrSystemStates <<
 	  " system state" << pluralize(nrSystemStates) << '.');
+  if (system.systemStates->usingStateHashing())
+    {
+      IssueAdvisory("model check used hash compaction; estimated probability that a state was omitted is " <<
+		    system.systemStates->getOmissionProbability() << '.');
+    }
 #ifdef TDEBUG
   if (result == true)
     {
-      dump(*(system.systemStates), mc.getLeadIn());
-      dump(*(system.systemStates), mc.getCycle());
+      dump(*(system.systemStates), leadIn);
+      dump(*(system.systemStates), cycle);
     }
 #endif
   delete newContext;
-  DagNode* resultDag = result ? makeCounterexample(*(system.systemStates), mc)
+  DagNode* resultDag = result ? makeCounterexample(*(system.systemStates), leadIn, cycle)
     : trueTerm.getDag();
   context.addInCount(*sysContext);
   delete system.systemStates;  // deletes sysContext via ~StateTransitionGraph()
@@ -315,3 +350,37 @@ ModelCheckerSymbol::SystemAutomaton::checkProposition(int stateNr, int propositi
   delete testContext;
   return result;
 }
+
+void
+ModelCheckerSymbol::SystemAutomaton::getCounters(Vector<Int64>& counters) const
+{
+  //
+  //	Rewrites are done in both parentContext (checking propositions) and
+  //	the context of systemStates (exploring the system); since the latter
+  //	is eventually added into the former we just report the totals.
+  //
+  const RewritingContext* sysContext = systemStates->getContext();
+  counters.resize(5);
+  counters[0] = parentContext->getMbCount() + sysContext->getMbCount();
+  counters[1] = parentContext->getEqCount() + sysContext->getEqCount();
+  counters[2] = parentContext->getRlCount() + sysContext->getRlCount();
+  counters[3] = parentContext->getNarrowingCount() + sysContext->getNarrowingCount();
+  counters[4] = parentContext->getVariantNarrowingCount() +
+    sysContext->getVariantNarrowingCount();
+}
+
+void
+ModelCheckerSymbol::SystemAutomaton::addCounters(const Vector<Int64>& counters)
+{
+  parentContext->incrementMbCount(counters[0]);
+  parentContext->incrementEqCount(counters[1]);
+  parentContext->incrementRlCount(counters[2]);
+  parentContext->incrementNarrowingCount(counters[3]);
+  parentContext->incrementVariantNarrowingCount(counters[4]);
+}
+
+bool
+ModelCheckerSymbol::SystemAutomaton::interrupted() const
+{
+  return RewritingContext::getTraceStatus();
+}
@@ -27,7 +27,7 @@
 #define _modelCheckerSymbol_hh_
 #include "temporalSymbol.hh"
 #include "cachedDag.hh"
-#include "modelChecker2.hh"
+#include "swarmModelChecker.hh"
 #include "stateTransitionGraph.hh"
 
 class ModelCheckerSymbol : public TemporalSymbol
@@ -54,12 +54,19 @@ public:
   bool eqRewrite(DagNode* subject, RewritingContext& context);
   void postInterSymbolPass();
   void reset();
+  //
+  //	Use a swarm of worker processes for model checking.
+  //
+  static void setNrProcesses(int nrProcesses);
 
 private:
-  struct SystemAutomaton : public ModelChecker2::System
+  struct SystemAutomaton : public SwarmModelChecker::System
   {
     int getNextState(int stateNr, int transitionNr);
     bool checkProposition(int stateNr, int propositionIndex) const;
+    void getCounters(Vector<Int64>& counters) const;
+    void addCounters(const Vector<Int64>& counters);
+    bool interrupted() const;
 
     DagNodeSet propositions;
     Symbol* satisfiesSymbol;
@@ -73,7 +80,11 @@ private:
   DagNode* makeTransitionList(const StateTransitionGraph& states,
 			      const list<int>& path,
 			      int lastTarget);
-  DagNode* makeCounterexample(const StateTransitionGraph& states, const ModelChecker2& mc);
+  DagNode* makeCounterexample(const StateTransitionGraph& states,
+			       const list<int>& leadIn,
+			       const list<int>& cycle);
+
+  static int nrProcesses;
 
   Symbol* satisfiesSymbol;
   //
@@ -90,4 +101,10 @@ private:
   CachedDag trueTerm;
 };
 
+inline void
+ModelCheckerSymbol::setNrProcesses(int nrProcesses)
+{
+  ModelCheckerSymbol::nrProcesses = nrProcesses;
+}
+
 #endif
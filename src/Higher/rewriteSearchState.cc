@@ -40,6 +40,7 @@
 #include "rewritingContext.hh"
 #include "rhsAutomaton.hh"
 #include "rule.hh"
+#include "parallelMatcher.hh"
 #include "rewriteSearchState.hh"
 
 RewriteSearchState::RewriteSearchState(RewritingContext* context,
@@ -79,8 +80,10 @@ RewriteSearchState::findNextRewrite()
       DagNode* d = getDagNode();
       if (!(d->isUnrewritable()))
 	{
-	  const Vector<Rule*>& rules = d->symbol()->getRules();
-	  for (int nrRules = rules.length(); ruleIndex < nrRules; ruleIndex++)
+	  Symbol* s = d->symbol();
+	  const Vector<Rule*>& rules = s->getRules();
+	  int nrRules = rules.length();
+	  for (; (ruleIndex = s->nextCandidateRule(d, ruleIndex)) < nrRules; ruleIndex++)
 	    {
 	      Rule* rl = rules[ruleIndex];
 	      if ((allowNonexec || !(rl->isNonexec())) &&
@@ -89,6 +92,7 @@ RewriteSearchState::findNextRewrite()
 		  LhsAutomaton* a = withExtension ? rl->getExtLhsAutomaton() :
 		    rl->getNonExtLhsAutomaton();
 		  //cerr << "trying " << rl << " at " << " positionIndex " <<  getPositionIndex() << " dagNode " << getDagNode() << endl;
+		  ParallelMatcher::Scope parallelMatching;
 		  if (findFirstSolution(rl, a))
 		    return true;
 		}
@@ -0,0 +1,447 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+
+//
+//	Implementation for class StateExpansionPool.
+//
+#include <signal.h>
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+//	utility stuff
+#include "macros.hh"
+#include "vector.hh"
+
+//	forward declarations
+#include "interface.hh"
+#include "core.hh"
+#include "higher.hh"
+
+//	interface class definitions
+#include "symbol.hh"
+#include "dagNode.hh"
+
+//	core class definitions
+#include "rewritingContext.hh"
+#include "rule.hh"
+#include "module.hh"
+
+//	higher class definitions
+#include "dagSerializer.hh"
+#include "rewriteSearchState.hh"
+#include "stateTransitionGraph.hh"
+#include "stateExpansionPool.hh"
+
+template<class T>
+inline void
+appendBytes(string& buffer, const T& data)
+{
+  buffer.append(reinterpret_cast<const char*>(&data), sizeof(T));
+}
+
+void
+StateExpansionPool::Counts::takeSnapshot(const RewritingContext& context)
+{
+  mbCount = context.getMbCount();
+  eqCount = context.getEqCount();
+  rlCount = context.getRlCount();
+  narrowingCount = context.getNarrowingCount();
+  variantNarrowingCount = context.getVariantNarrowingCount();
+}
+
+void
+StateExpansionPool::Counts::makeDelta(const RewritingContext& context)
+{
+  mbCount = context.getMbCount() - mbCount;
+  eqCount = context.getEqCount() - eqCount;
+  rlCount = context.getRlCount() - rlCount;
+  narrowingCount = context.getNarrowingCount() - narrowingCount;
+  variantNarrowingCount = context.getVariantNarrowingCount() - variantNarrowingCount;
+}
+
+void
+StateExpansionPool::Counts::addTo(RewritingContext& context) const
+{
+  context.incrementMbCount(mbCount);
+  context.incrementEqCount(eqCount);
+  context.incrementRlCount(rlCount);
+  context.incrementNarrowingCount(narrowingCount);
+  context.incrementVariantNarrowingCount(variantNarrowingCount);
+}
+
+StateExpansionPool::StateExpansionPool(int nrProcesses, DagSerializer* serializer)
+  : nrProcesses(nrProcesses),
+    serializer(serializer)
+{
+  Assert(nrProcesses > 1, "need at least 2 processes");
+  blockStart = 0;
+  blockSize = 0;
+  nrStatesFinished = 0;
+  readPointer = 0;
+  readEnd = 0;
+}
+
+bool
+StateExpansionPool::expand(StateTransitionGraph& graph, int stateNr)
+{
+  if (stateNr >= blockStart && stateNr < blockStart + blockSize)
+    return true;
+  //
+  //	We don't start a new block until every state in the current block
+  //	has been fully handed over, since pending results would otherwise
+  //	be lost.
+  //
+  if (nrStatesFinished < blockSize)
+    return false;
+  //
+  //	Tracing, breakpoints, profiling, print attributes and interrupts
+  //	all need the parent to see each rewrite as it happens.
+  //
+  if (RewritingContext::getTraceStatus())
+    return false;
+  //
+  //	The block is the run of untouched states starting at stateNr.
+  //
+  int end = graph.seen.size();
+  if (end - stateNr > nrProcesses * MAX_STATES_PER_PROCESS)
+    end = stateNr + nrProcesses * MAX_STATES_PER_PROCESS;
+  int i = stateNr;
+  while (i < end && graph.isUntouched(i))
+    ++i;
+  int nrStates = i - stateNr;
+  if (nrStates < MIN_BLOCK_SIZE)
+    return false;
+  return expandBlock(graph, stateNr, nrStates);
+}
+
+bool
+StateExpansionPool::expandBlock(StateTransitionGraph& graph, int firstStateNr, int nrStates)
+{
+  blockStart = firstStateNr;
+  blockSize = 0;  // in case we fail
+  nrStatesFinished = 0;
+  //
+  //	Make sure nothing buffered gets output twice.
+  //
+  cout.flush();
+  cerr.flush();
+
+  Vector<pid_t> pids;
+  Vector<int> fds;
+  for (int i = 0; i < nrProcesses; ++i)
+    {
+      int pipeFds[2];
+      if (pipe(pipeFds) == -1)
+	{
+	  killWorkers(pids, fds);
+	  return false;
+	}
+      pid_t pid = fork();
+      if (pid == -1)
+	{
+	  close(pipeFds[0]);
+	  close(pipeFds[1]);
+	  killWorkers(pids, fds);
+	  return false;
+	}
+      if (pid == 0)
+	{
+	  //
+	  //	Child - we don't want to hold the read ends of our siblings' pipes
+	  //	open, or our own.
+	  //
+	  for (int fd : fds)
+	    close(fd);
+	  close(pipeFds[0]);
+	  blockSize = nrStates;
+	  runWorker(graph, i, pipeFds[1]);
+	}
+      close(pipeFds[1]);
+      pids.append(pid);
+      fds.append(pipeFds[0]);
+    }
+
+  blockSize = nrStates;
+  if (collectResults(pids, fds) && indexResults())
+    return true;
+  blockSize = 0;
+  results.clear();
+  return false;
+}
+
+void
+StateExpansionPool::runWorker(StateTransitionGraph& graph, int workerNr, int fd)
+{
+  //
+  //	Interrupts are dealt with by our parent, which will kill us.
+  //
+  signal(SIGINT, SIG_IGN);
+  RewritingContext& initial = *(graph.initial);
+  string buffer;
+  int end = blockStart + blockSize;
+  for (int i = blockStart + workerNr; i < end; i += nrProcesses)
+    {
+      for (;;)
+	{
+	  Counts counts;
+	  counts.takeSnapshot(initial);
+	  Rule* rule;
+	  DagNode* successor = graph.computeNextSuccessor(i, rule);
+	  counts.makeDelta(initial);
+	  if (successor == 0)
+	    {
+	      if (graph.seen[i].successors == StateTransitionGraph::UNEXPLORED)
+		_exit(EXIT_FAILURE);  // aborted
+	      buffer += END_OF_STATE;
+	      appendBytes(buffer, counts);
+	      break;
+	    }
+	  buffer += SUCCESSOR;
+	  appendBytes(buffer, counts);
+	  appendBytes(buffer, rule->getIndexWithinModule());
+	  Rope encoding = serializer->serialize(successor);
+	  size_t length = encoding.length();
+	  appendBytes(buffer, length);
+	  size_t oldSize = buffer.size();
+	  buffer.resize(oldSize + length);
+	  encoding.copy(&buffer[oldSize]);
+	  if (buffer.size() >= WRITE_CHUNK_SIZE)
+	    {
+	      if (!writeAll(fd, buffer))
+		_exit(EXIT_FAILURE);
+	      buffer.clear();
+	    }
+	  MemoryCell::okToCollectGarbage();
+	}
+    }
+  if (!writeAll(fd, buffer))
+    _exit(EXIT_FAILURE);
+  close(fd);
+  _exit(EXIT_SUCCESS);
+}
+
+bool
+StateExpansionPool::writeAll(int fd, const string& buffer)
+{
+  const char* p = buffer.data();
+  size_t nrBytes = buffer.size();
+  while (nrBytes > 0)
+    {
+      ssize_t n = write(fd, p, nrBytes);
+      if (n == -1)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  return false;
+	}
+      p += n;
+      nrBytes -= n;
+    }
+  return true;
+}
+
+bool
+StateExpansionPool::collectResults(const Vector<pid_t>& pids, const Vector<int>& fds)
+{
+  results.clear();
+  results.resize(nrProcesses);
+  Vector<pollfd> ufds(nrProcesses);
+  for (int i = 0; i < nrProcesses; ++i)
+    {
+      ufds[i].fd = fds[i];
+      ufds[i].events = POLLIN;
+    }
+  char readBuffer[READ_BUFFER_SIZE];
+  int nrOpen = nrProcesses;
+  while (nrOpen > 0)
+    {
+      if (poll(&ufds[0], nrProcesses, -1) == -1)
+	{
+	  if (errno == EINTR && !RewritingContext::getTraceStatus())
+	    continue;
+	  //
+	  //	Interrupted by the user or something went wrong.
+	  //
+	  killWorkers(pids, fds);
+	  return false;
+	}
+      for (int i = 0; i < nrProcesses; ++i)
+	{
+	  if (ufds[i].fd == -1 || ufds[i].revents == 0)
+	    continue;
+	  ssize_t n = ::read(ufds[i].fd, readBuffer, READ_BUFFER_SIZE);
+	  if (n > 0)
+	    results[i].append(readBuffer, n);
+	  else if (n == 0)
+	    {
+	      close(ufds[i].fd);
+	      ufds[i].fd = -1;  // ignored by poll()
+	      --nrOpen;
+	    }
+	  else if (errno != EINTR)
+	    {
+	      killWorkers(pids, fds);
+	      return false;
+	    }
+	}
+    }
+  //
+  //	All pipes have been closed; now reap workers and check that each
+  //	one succeeded.
+  //
+  bool ok = true;
+  for (pid_t pid : pids)
+    {
+      int wstatus;
+      while (waitpid(pid, &wstatus, 0) == -1)
+	{
+	  if (errno != EINTR)
+	    {
+	      ok = false;
+	      break;
+	    }
+	}
+      if (!(WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == EXIT_SUCCESS))
+	ok = false;
+    }
+  return ok;
+}
+
+void
+StateExpansionPool::killWorkers(const Vector<pid_t>& pids, const Vector<int>& fds)
+{
+  for (pid_t pid : pids)
+    kill(pid, SIGKILL);
+  for (int fd : fds)
+    close(fd);  // may already be closed
+  for (pid_t pid : pids)
+    {
+      while (waitpid(pid, 0, 0) == -1 && errno == EINTR)
+	;
+    }
+}
+
+void
+StateExpansionPool::read(void* data, size_t nrBytes)
+{
+  Assert(readPointer + nrBytes <= readEnd, "read past end of results");
+  memcpy(data, readPointer, nrBytes);
+  readPointer += nrBytes;
+}
+
+bool
+StateExpansionPool::indexResults()
+{
+  //
+  //	Find where the records for each state in the block start, checking
+  //	that each worker produced well formed output for all of its states.
+  //
+  positions.resize(blockSize);
+  for (int i = 0; i < nrProcesses; ++i)
+    {
+      const char* start = results[i].data();
+      readPointer = start;
+      readEnd = start + results[i].size();
+      for (int j = i; j < blockSize; j += nrProcesses)
+	{
+	  positions[j] = readPointer - start;
+	  for (;;)
+	    {
+	      if (readEnd - readPointer < 1 + static_cast<ptrdiff_t>(sizeof(Counts)))
+		return false;
+	      char type;
+	      read(&type, 1);
+	      readPointer += sizeof(Counts);
+	      if (type == END_OF_STATE)
+		break;
+	      if (type != SUCCESSOR ||
+		  readEnd - readPointer < static_cast<ptrdiff_t>(sizeof(int) + sizeof(size_t)))
+		return false;
+	      readPointer += sizeof(int);
+	      size_t length;
+	      read(&length, sizeof(length));
+	      if (static_cast<size_t>(readEnd - readPointer) < length)
+		return false;
+	      readPointer += length;
+	    }
+	}
+      if (readPointer != readEnd)
+	return false;
+    }
+  return true;
+}
+
+DagNode*
+StateExpansionPool::getNextSuccessor(StateTransitionGraph& graph, int stateNr, Rule*& rule)
+{
+  int index = stateNr - blockStart;
+  Assert(index >= 0 && index < blockSize, "state " << stateNr << " not in block");
+  const string& result = results[index % nrProcesses];
+  readPointer = result.data() + positions[index];
+  readEnd = result.data() + result.size();
+  //
+  //	Rewrites done by the worker count as if we had done them ourselves.
+  //
+  char type;
+  read(&type, 1);
+  Counts counts;
+  read(&counts, sizeof(counts));
+  RewritingContext* initial = graph.initial;
+  counts.addTo(*initial);
+  if (type == END_OF_STATE)
+    {
+      positions[index] = readPointer - result.data();
+      if (++nrStatesFinished == blockSize)
+	{
+	  //
+	  //	Free the memory used for results.
+	  //
+	  results.clear();
+	  positions.clear();
+	}
+      return 0;
+    }
+
+  int ruleIndex;
+  read(&ruleIndex, sizeof(ruleIndex));
+  size_t length;
+  read(&length, sizeof(length));
+  const char* encoding = readPointer;
+  readPointer += length;
+  positions[index] = readPointer - result.data();
+
+  Module* module = initial->root()->symbol()->getModule();
+  rule = module->getRules()[ruleIndex];
+  //
+  //	The worker returned a fully reduced dag; we reduce our copy to
+  //	recover normal form and sort information. Any rewrites in doing so
+  //	were already counted by the worker.
+  //
+  RewritingContext* c = initial->makeSubcontext(serializer->deserialize(encoding, length));
+  c->reduce();
+  DagNode* successor = c->root();
+  delete c;
+  return successor;
+}
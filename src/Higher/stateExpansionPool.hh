@@ -0,0 +1,109 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	Class for computing the successors of blocks of states of a
+//	StateTransitionGraph using a pool of worker processes.
+//
+//	The rewriting engine is single threaded so each worker is a fork()ed
+//	copy of the current process. A worker explores its share of a block
+//	of states in its own copy of the graph and passes the successor dags
+//	back in serialized form, together with the rewrite counts that
+//	accrued in finding each of them. The parent then hands the
+//	successors over to the graph one at a time, in exactly the order
+//	that sequential exploration would have found them, so that state
+//	numbering, rewrite counts and paths are unchanged.
+//
+#ifndef _stateExpansionPool_hh_
+#define _stateExpansionPool_hh_
+#include <sys/types.h>
+
+class StateExpansionPool
+{
+  NO_COPYING(StateExpansionPool);
+
+public:
+  StateExpansionPool(int nrProcesses, DagSerializer* serializer);
+  //
+  //	Returns true if the successors of stateNr are available from a
+  //	block that has been, or can now be, expanded by worker processes.
+  //
+  bool expand(StateTransitionGraph& graph, int stateNr);
+  //
+  //	Returns the next successor of stateNr and the rule that produced it,
+  //	or 0 if there are no more.
+  //
+  DagNode* getNextSuccessor(StateTransitionGraph& graph, int stateNr, Rule*& rule);
+
+private:
+  enum Parameters
+  {
+    MIN_BLOCK_SIZE = 64,		// don't bother forking for fewer states
+    MAX_STATES_PER_PROCESS = 4096,	// bounds memory used for pending results
+    WRITE_CHUNK_SIZE = 64 * 1024,	// buffer this much before writing
+    READ_BUFFER_SIZE = 64 * 1024
+  };
+
+  enum RecordType
+  {
+    SUCCESSOR = 's',
+    END_OF_STATE = 'e'
+  };
+
+  struct Counts
+  {
+    void takeSnapshot(const RewritingContext& context);
+    void makeDelta(const RewritingContext& context);	// counts since snapshot
+    void addTo(RewritingContext& context) const;
+
+    Int64 mbCount;
+    Int64 eqCount;
+    Int64 rlCount;
+    Int64 narrowingCount;
+    Int64 variantNarrowingCount;
+  };
+
+  bool expandBlock(StateTransitionGraph& graph, int firstStateNr, int nrStates);
+  void runWorker(StateTransitionGraph& graph, int workerNr, int fd);
+  bool collectResults(const Vector<pid_t>& pids, const Vector<int>& fds);
+  bool indexResults();
+  void read(void* data, size_t nrBytes);
+
+  static void killWorkers(const Vector<pid_t>& pids, const Vector<int>& fds);
+  static bool writeAll(int fd, const string& buffer);
+
+  const int nrProcesses;
+  DagSerializer* const serializer;
+  //
+  //	The current block of states; state blockStart + i is handled by
+  //	worker i % nrProcesses.
+  //
+  int blockStart;
+  int blockSize;
+  Vector<string> results;		// raw output of each worker
+  Vector<size_t> positions;		// read position for each state in block
+  int nrStatesFinished;
+  const char* readPointer;
+  const char* readEnd;
+};
+
+#endif
@@ -24,6 +24,9 @@
 //	Implementation for class StateTransitionGraph.
 //
 
+#include <string.h>
+#include <errno.h>
+
 //	utility stuff
 #include "macros.hh"
 #include "vector.hh"
@@ -38,144 +41,584 @@
 #include "dagNode.hh"
 
 //	core class definitions
+#include "module.hh"
+
+//	higher class definitions
+#include "dagSerializer.hh"
 #include "rewriteSearchState.hh"
 #include "stateTransitionGraph.hh"
+#include "stateExpansionPool.hh"
+#include "diskStateStore.hh"
+#include "fingerprintTable.hh"
+
+bool StateTransitionGraph::compactMode = false;
+string StateTransitionGraph::stateStoreDirectory;
+bool StateTransitionGraph::hashCompaction = false;
+int StateTransitionGraph::bitstateLog2NrBits = 0;
+int StateTransitionGraph::bitstateNrHashFunctions = 0;
 
 StateTransitionGraph::StateTransitionGraph(RewritingContext* initial)
   : initial(initial)
 {
+  expansionPool = 0;
+  stateStore = 0;
+  fingerprints = 0;
+  for (Cursor& c : cursors)
+    c.stateNr = NONE;
   initial->reduce();
   int hashConsIndex = hashConsSet.insert(initial->root());
   hashCons2seen.resize(hashConsIndex + 1);
   for (int i = 0; i < hashConsIndex; ++i)
     hashCons2seen[i] = NONE;
   hashCons2seen[hashConsIndex] = seen.size();
-  seen.append(new State(hashConsIndex, NONE));
+  seen.append(State(hashConsIndex, NONE));
+  if (!compactMode)
+    fwdArcs.append(0);
 }
 
 StateTransitionGraph::~StateTransitionGraph()
 {
-  int nrStates = seen.length();
-  for (int i = 0; i < nrStates; i++)
+  for (PartialMap::value_type& p : partialStates)
+    delete p.second.rewriteState;
+  for (ArcMap* a : fwdArcs)
+    delete a;
+  delete expansionPool;
+  delete stateStore;
+  delete fingerprints;
+  delete initial;
+}
+
+void
+StateTransitionGraph::setExpansionPool(int nrProcesses, DagSerializer* serializer)
+{
+  delete expansionPool;
+  expansionPool = (nrProcesses > 1) ? new StateExpansionPool(nrProcesses, serializer) : 0;
+}
+
+void
+StateTransitionGraph::useStateStore()
+{
+  if (stateStoreDirectory.empty() || stateStore != 0 || fingerprints != 0)
+    return;
+  Assert(seen.size() == 1 && isUntouched(0), "graph already explored");
+  DagNode* initialDag = getStateDag(0);
+  DagSerializer* serializer = dynamic_cast<DagSerializer*>(initialDag->symbol()->getModule());
+  if (serializer == 0)
+    return;
+  DiskStateStore* store = new DiskStateStore(serializer);
+  if (!(store->open(stateStoreDirectory.c_str())))
     {
-      delete seen[i]->rewriteState;
-      delete seen[i];
+      IssueWarning("unable to create state store in " << QUOTE(stateStoreDirectory) <<
+		   ": " << strerror(errno) << "; keeping states in memory.");
+      delete store;
+      return;
     }
-  delete initial;
+  //
+  //	From now on the hash cons index of a state is the index of its
+  //	record in the state store, which is the same as its state number.
+  //
+  bool isNew;
+  seen[0].hashConsIndex = store->insert(initialDag, isNew);
+  materializedDags[0] = initialDag;
+  stateStore = store;
+}
+
+void
+StateTransitionGraph::useStateHashing(bool needStateIdentity)
+{
+  if (fingerprints != 0 || stateStore != 0)
+    return;
+  Assert(seen.size() == 1 && isUntouched(0), "graph already explored");
+  Uint64 initialFingerprint = FingerprintTable::fingerprint(getStateDag(0));
+  if (bitstateLog2NrBits > 0 && !needStateIdentity)
+    fingerprints = new FingerprintTable(bitstateLog2NrBits, bitstateNrHashFunctions);
+  else if (hashCompaction || bitstateLog2NrBits > 0)
+    fingerprints = new FingerprintTable;
+  else
+    return;
+  (void) fingerprints->insert(initialFingerprint, 0);
+  //
+  //	The initial state dag stays in hashConsSet; no other state dags
+  //	go there.
+  //
+}
+
+double
+StateTransitionGraph::getOmissionProbability() const
+{
+  return (fingerprints == 0) ? 0.0 : fingerprints->getOmissionProbability();
 }
 
 int
 StateTransitionGraph::getNextState(int stateNr, int index)
 {
-  State* n = seen[stateNr];
-  int nrNextStates = n->nextStates.length();
-  if (index < nrNextStates)
-    return n->nextStates[index];
-  if (n->fullyExplored)
-    return NONE;
-  if (n->rewriteState == 0)
+  flushCaches();
+  if (seen[stateNr].successors != UNEXPLORED)
+    return getSuccessor(stateNr, index);
+
+  int nrNextStates = 0;
+  bool rewriteStarted = false;
+  PartialMap::const_iterator i = partialStates.find(stateNr);
+  if (i != partialStates.end())
     {
-      DagNode* canonicalStateDag = hashConsSet.getCanonical(seen[stateNr]->hashConsIndex);
-      RewritingContext* newContext = initial->makeSubcontext(canonicalStateDag);
-      n->rewriteState = new RewriteSearchState(newContext,
-					       NONE,
-					       RewriteSearchState::GC_CONTEXT |
-					       RewriteSearchState::SET_UNREWRITABLE |
-					       PositionState::SET_UNSTACKABLE,
-					       0,
-					       UNBOUNDED);
+      const Vector<int>& nextStates = i->second.nextStates;
+      nrNextStates = nextStates.length();
+      if (index < nrNextStates)
+	return nextStates[index];
+      rewriteStarted = (i->second.rewriteState != 0);
     }
 
-  RewriteSearchState* rewriteState = n->rewriteState;
-  RewritingContext *context = rewriteState->getContext();
-  while (nrNextStates <= index)
+  if (!rewriteStarted && expansionPool != 0 && expansionPool->expand(*this, stateNr))
     {
-      bool success = rewriteState->findNextRewrite();
-      rewriteState->transferCountTo(*initial);
-      
-      if (success)
+      //
+      //	Successors of stateNr were computed by a worker process; we
+      //	add them to the graph one at a time, as they are asked for, so
+      //	that state numbering is the same as for sequential exploration.
+      //
+      while (nrNextStates <= index)
 	{
-	  Rule* rule = rewriteState->getRule();
-	  bool trace = RewritingContext::getTraceStatus();
-	  if (trace)
+	  Rule* rule;
+	  DagNode* successor = expansionPool->getNextSuccessor(*this, stateNr, rule);
+	  if (successor == 0)
 	    {
-	      context->tracePreRuleRewrite(rewriteState->getDagNode(), rule);
-	      if (context->traceAbort())
-		return NONE;
+	      finishState(stateNr);
+	      return NONE;
 	    }
-	  DagNode* replacement = rewriteState->getReplacement();
-	  RewriteSearchState::DagPair r = rewriteState->rebuildDag(replacement);
-          RewritingContext* c = context->makeSubcontext(r.first);
-	  initial->incrementRlCount();
-	  if (trace)
-	    {
-	      c->tracePostRuleRewrite(r.second);
-	      if (c->traceAbort())
-		{
-		  delete c;
-		  return NONE;
-		}
-	    }
-	  c->reduce();
-	  if (c->traceAbort())
-            {
-              delete c;
-              return NONE;
-            }
-	  initial->addInCount(*c);
+	  (void) addArc(stateNr, successor, rule);
+	  ++nrNextStates;
+	  MemoryCell::okToCollectGarbage();
+	}
+      return partialStates[stateNr].nextStates[index];
+    }
+
+  while (nrNextStates <= index)
+    {
+      Rule* rule;
+      DagNode* successor = computeNextSuccessor(stateNr, rule);
+      if (successor == 0)
+	return NONE;  // either no more successors or we were aborted
+      (void) addArc(stateNr, successor, rule);
+      ++nrNextStates;
+      //
+      //	If we didn't do any equational rewriting we will not have had a chance to
+      //	collect garbage.
+      //
+      MemoryCell::okToCollectGarbage();
+    }
+  return partialStates[stateNr].nextStates[index];
+}
+
+DagNode*
+StateTransitionGraph::computeNextSuccessor(int stateNr, Rule*& rule)
+{
+  //
+  //	Find the next rewrite from stateNr and return the reduced result,
+  //	or 0 if there are no more rewrites or we were aborted. In the former
+  //	case we mark stateNr as fully explored.
+  //
+  PartialState& p = partialStates[stateNr];
+  if (p.rewriteState == 0)
+    {
+      RewritingContext* newContext = initial->makeSubcontext(getStateDag(stateNr));
+      p.rewriteState = new RewriteSearchState(newContext,
+					      NONE,
+					      RewriteSearchState::GC_CONTEXT |
+					      RewriteSearchState::SET_UNREWRITABLE |
+					      PositionState::SET_UNSTACKABLE,
+					      0,
+					      UNBOUNDED);
+    }
+
+  RewriteSearchState* rewriteState = p.rewriteState;
+  RewritingContext *context = rewriteState->getContext();
+  bool success = rewriteState->findNextRewrite();
+  rewriteState->transferCountTo(*initial);
+  if (!success)
+    {
+      finishState(stateNr);  // deletes rewriteState
+      return 0;
+    }
+
+  rule = rewriteState->getRule();
+  bool trace = RewritingContext::getTraceStatus();
+  if (trace)
+    {
+      context->tracePreRuleRewrite(rewriteState->getDagNode(), rule);
+      if (context->traceAbort())
+	return 0;
+    }
+  DagNode* replacement = rewriteState->getReplacement();
+  RewriteSearchState::DagPair r = rewriteState->rebuildDag(replacement);
+  RewritingContext* c = context->makeSubcontext(r.first);
+  initial->incrementRlCount();
+  if (trace)
+    {
+      c->tracePostRuleRewrite(r.second);
+      if (c->traceAbort())
+	{
 	  delete c;
+	  return 0;
+	}
+    }
+  c->reduce();
+  if (c->traceAbort())
+    {
+      delete c;
+      return 0;
+    }
+  initial->addInCount(*c);
+  delete c;
+  return r.first;
+}
 
-	  int nextState;
-	  int hashConsIndex = hashConsSet.insert(r.first);
-	  int mapSize = hashCons2seen.size();
-	  //DebugAdvisory("replacement dag = " << r.first << "hashConsIndex = " << hashConsIndex);
-	  if (hashConsIndex >= mapSize)
-	    {
-	      //
-	      //	Definitely a new state.
-	      //
-	      hashCons2seen.resize(hashConsIndex + 1);
-	      for (int i = mapSize; i < hashConsIndex; ++i)
-		hashCons2seen[i] = NONE;
-	      nextState = seen.size();
-	      hashCons2seen[hashConsIndex] = nextState;
-	      seen.append(new State(hashConsIndex, stateNr));
-	      DebugAdvisory("new state dag = " << r.first <<
-			    " hashConsIndex = " << hashConsIndex <<
-			    " collisionCounter = " << hashConsSet.collisionCounter);
-	    }
-	  else
-	    {
-	      //
-	      //	Seen before.
-	      //
-	      nextState = hashCons2seen[hashConsIndex];
-	      if (nextState == NONE)
-		{
-		  //
-		  //	 But only as a subdag, not as a state dag, so it counts as a new state.
-		  //
-		  nextState = seen.size();
-		  hashCons2seen[hashConsIndex] = nextState;
-		  seen.append(new State(hashConsIndex, stateNr));
-		}
-	    }
-	  n->nextStates.append(nextState);
-	  n->fwdArcs[nextState].insert(rule);
-	  ++nrNextStates;
+int
+StateTransitionGraph::addArc(int stateNr, DagNode* successor, Rule* rule)
+{
+  int nextState;
+  if (stateStore != 0)
+    {
+      bool isNew;
+      nextState = stateStore->insert(successor, isNew);
+      if (isNew)
+	{
+	  Assert(nextState == seen.length(), "state store out of step");
+	  seen.append(State(nextState, stateNr));
+	  if (!compactMode)
+	    fwdArcs.append(0);
+	  materializedDags[nextState] = successor;  // likely to be needed soon
+	}
+    }
+  else if (fingerprints != 0)
+    {
+      int nrStates = seen.size();
+      nextState = fingerprints->insert(FingerprintTable::fingerprint(successor), nrStates);
+      if (nextState == nrStates)
+	{
+	  seen.append(State(NONE, stateNr));
+	  if (!compactMode)
+	    fwdArcs.append(0);
+	  unexploredDags[nextState] = successor;
+	}
+    }
+  else
+    nextState = insertInHashConsSet(stateNr, successor);
+  partialStates[stateNr].nextStates.append(nextState);
+  if (!compactMode && nextState >= 0)  // we don't record arcs to unknown states
+    {
+      ArcMap*& arcs = fwdArcs[stateNr];
+      if (arcs == 0)
+	arcs = new ArcMap;
+      (*arcs)[nextState].insert(rule);
+    }
+  return nextState;
+}
+
+int
+StateTransitionGraph::insertInHashConsSet(int stateNr, DagNode* successor)
+{
+  int nextState;
+  int hashConsIndex = hashConsSet.insert(successor);
+  int mapSize = hashCons2seen.size();
+  //DebugAdvisory("replacement dag = " << successor << "hashConsIndex = " << hashConsIndex);
+  if (hashConsIndex >= mapSize)
+    {
+      //
+      //	Definitely a new state.
+      //
+      hashCons2seen.resize(hashConsIndex + 1);
+      for (int i = mapSize; i < hashConsIndex; ++i)
+	hashCons2seen[i] = NONE;
+      nextState = seen.size();
+      hashCons2seen[hashConsIndex] = nextState;
+      seen.append(State(hashConsIndex, stateNr));
+      if (!compactMode)
+	fwdArcs.append(0);
+      DebugAdvisory("new state dag = " << successor <<
+		    " hashConsIndex = " << hashConsIndex <<
+		    " collisionCounter = " << hashConsSet.collisionCounter);
+    }
+  else
+    {
+      //
+      //	Seen before.
+      //
+      nextState = hashCons2seen[hashConsIndex];
+      if (nextState == NONE)
+	{
 	  //
-	  //	If we didn't do any equational rewriting we will not have had a chance to
-	  //	collect garbage.
+	  //	 But only as a subdag, not as a state dag, so it counts as a new state.
 	  //
-	  MemoryCell::okToCollectGarbage();
+	  nextState = seen.size();
+	  hashCons2seen[hashConsIndex] = nextState;
+	  seen.append(State(hashConsIndex, stateNr));
+	  if (!compactMode)
+	    fwdArcs.append(0);
+	}
+    }
+  return nextState;
+}
+
+void
+StateTransitionGraph::finishState(int stateNr)
+{
+  //
+  //	stateNr has been fully explored so we move its successors out of
+  //	its partial state and into successorCodes.
+  //
+  PartialMap::iterator i = partialStates.find(stateNr);
+  Assert(i != partialStates.end(), "no partial state for " << stateNr);
+  const Vector<int>& nextStates = i->second.nextStates;
+  seen[stateNr].successors = successorCodes.size();
+  appendCode(nextStates.size());
+  Int64 previous = stateNr;
+  for (int n : nextStates)
+    {
+      Int64 difference = n - previous;
+      appendCode((static_cast<Uint64>(difference) << 1) ^ static_cast<Uint64>(difference >> 63));
+      previous = n;
+    }
+  delete i->second.rewriteState;
+  partialStates.erase(i);
+  if (fingerprints != 0)
+    unexploredDags.erase(stateNr);  // we can regenerate it if needed
+}
+
+void
+StateTransitionGraph::appendCode(Uint64 code)
+{
+  while (code >= 0x80)
+    {
+      successorCodes.append(static_cast<unsigned char>(code | 0x80));
+      code >>= 7;
+    }
+  successorCodes.append(static_cast<unsigned char>(code));
+}
+
+int
+StateTransitionGraph::getNrSuccessors(int stateNr) const
+{
+  if (seen[stateNr].successors == UNEXPLORED)
+    {
+      PartialMap::const_iterator i = partialStates.find(stateNr);
+      return (i == partialStates.end()) ? 0 : i->second.nextStates.length();
+    }
+  return getCursor(stateNr).nrSuccessors;
+}
+
+int
+StateTransitionGraph::getSuccessor(int stateNr, int index) const
+{
+  if (seen[stateNr].successors == UNEXPLORED)
+    {
+      PartialMap::const_iterator i = partialStates.find(stateNr);
+      Assert(i != partialStates.end(), "no partial state for " << stateNr);
+      return i->second.nextStates[index];
+    }
+  Cursor& c = getCursor(stateNr);
+  if (index >= c.nrSuccessors)
+    return NONE;
+  if (index < c.index)
+    {
+      //
+      //	Going backwards; restart from the first successor.
+      //
+      c.position = seen[stateNr].successors;
+      (void) readCode(c.position);
+      c.index = NONE;
+      c.successor = stateNr;
+    }
+  while (c.index < index)
+    {
+      Uint64 code = readCode(c.position);
+      c.successor += static_cast<Int64>(code >> 1) ^ -static_cast<Int64>(code & 1);
+      ++c.index;
+    }
+  return c.successor;
+}
+
+const StateTransitionGraph::ArcMap&
+StateTransitionGraph::getStateFwdArcs(int stateNr) const
+{
+  if (!compactMode)
+    {
+      static const ArcMap noArcs;
+      const ArcMap* arcs = fwdArcs[stateNr];
+      return (arcs == 0) ? noArcs : *arcs;
+    }
+  RecomputedArcMap::const_iterator i = recomputedArcs.find(stateNr);
+  if (i != recomputedArcs.end())
+    return i->second;
+  if (recomputedArcs.size() >= MAX_CACHED_STATES)
+    recomputedArcs.clear();
+  return recomputeArcs(stateNr);
+}
+
+const StateTransitionGraph::ArcMap&
+StateTransitionGraph::recomputeArcs(int stateNr) const
+{
+  //
+  //	Redo the rewrites from stateNr, in the same order as before, to
+  //	find out which rule produced each successor. Rewrites done in
+  //	solving conditions were counted the first time around so we
+  //	throw away the counts.
+  //
+  ArcMap& arcs = recomputedArcs[stateNr];
+  int nrSuccessors = getNrSuccessors(stateNr);
+  if (nrSuccessors > 0)
+    {
+      RewritingContext* context = initial->makeSubcontext(getStateDag(stateNr));
+      RewriteSearchState rewriteState(context,
+				      NONE,
+				      RewriteSearchState::GC_CONTEXT |
+				      RewriteSearchState::SET_UNREWRITABLE |
+				      PositionState::SET_UNSTACKABLE,
+				      0,
+				      UNBOUNDED);
+      for (int i = 0; i < nrSuccessors && rewriteState.findNextRewrite(); ++i)
+	{
+	  int successor = getSuccessor(stateNr, i);
+	  if (successor >= 0)
+	    arcs[successor].insert(rewriteState.getRule());
 	}
-      else
+    }
+  return arcs;
+}
+
+DagNode*
+StateTransitionGraph::materialize(int stateNr) const
+{
+  DagMap::const_iterator i = materializedDags.find(stateNr);
+  if (i != materializedDags.end())
+    return i->second;
+  if (fingerprints != 0)
+    {
+      i = unexploredDags.find(stateNr);
+      if (i != unexploredDags.end())
+	return i->second;
+      return replay(stateNr);
+    }
+  //
+  //	Rebuild the dag from its encoding and reduce it to recover normal
+  //	form and sort information. It was already in normal form when we
+  //	stored it so we don't count any rewrites.
+  //
+  RewritingContext* context =
+    initial->makeSubcontext(stateStore->fetch(seen[stateNr].hashConsIndex));
+  context->reduce();
+  DagNode* d = context->root();
+  materializedDags[stateNr] = d;
+  delete context;
+  return d;
+}
+
+DagNode*
+StateTransitionGraph::replay(int stateNr) const
+{
+  //
+  //	We no longer have the dag for stateNr so we regenerate it, starting
+  //	from the nearest ancestor whose dag we have and redoing the rewrite
+  //	that produced each state on the way down.
+  //
+  Vector<int> path;
+  DagNode* d;
+  for (int s = stateNr;; s = seen[s].parent)
+    {
+      if (s == 0)
 	{
-	  delete rewriteState;
-	  n->fullyExplored = true;
-	  n->rewriteState = 0;
-	  return NONE;
+	  d = hashConsSet.getCanonical(seen[0].hashConsIndex);
+	  break;
 	}
+      DagMap::const_iterator i = unexploredDags.find(s);
+      if (i != unexploredDags.end())
+	{
+	  d = i->second;
+	  break;
+	}
+      i = materializedDags.find(s);
+      if (i != materializedDags.end())
+	{
+	  d = i->second;
+	  break;
+	}
+      path.append(s);
     }
-  return n->nextStates[index];
+  for (int j = path.length() - 1; j >= 0; --j)
+    {
+      int s = path[j];
+      d = regenerate(d, seen[s].parent, s);
+      materializedDags[s] = d;
+    }
+  return d;
+}
+
+DagNode*
+StateTransitionGraph::regenerate(DagNode* parentDag, int parentNr, int stateNr) const
+{
+  //
+  //	stateNr was first reached by the first arc from parentNr to it;
+  //	we redo that rewrite without counting it.
+  //
+  int index = 0;
+  while (getSuccessor(parentNr, index) != stateNr)
+    ++index;
+  RewritingContext* context = initial->makeSubcontext(parentDag);
+  RewriteSearchState rewriteState(context,
+				  NONE,
+				  RewriteSearchState::GC_CONTEXT |
+				  RewriteSearchState::SET_UNREWRITABLE |
+				  PositionState::SET_UNSTACKABLE,
+				  0,
+				  UNBOUNDED);
+  for (int i = 0; i <= index; ++i)
+    {
+      bool success = rewriteState.findNextRewrite();
+      Assert(success, "lost rewrite " << i << " for state " << parentNr);
+    }
+  RewriteSearchState::DagPair r = rewriteState.rebuildDag(rewriteState.getReplacement());
+  RewritingContext* c = context->makeSubcontext(r.first);
+  c->reduce();
+  delete c;
+  return r.first;
+}
+
+void
+StateTransitionGraph::prefetchState(int stateNr) const
+{
+  (void) getStateDag(stateNr);
+  if (compactMode && recomputedArcs.find(stateNr) == recomputedArcs.end())
+    (void) recomputeArcs(stateNr);
+}
+
+void
+StateTransitionGraph::flushCaches()
+{
+  if (materializedDags.size() > MAX_CACHED_STATES)
+    materializedDags.clear();
+  if (recomputedArcs.size() > MAX_CACHED_STATES)
+    recomputedArcs.clear();
+}
+
+void
+StateTransitionGraph::markReachableNodes()
+{
+  for (const DagMap::value_type& p : materializedDags)
+    p.second->mark();
+  for (const DagMap::value_type& p : unexploredDags)
+    p.second->mark();
+}
+
+size_t
+StateTransitionGraph::getNrBytesUsed() const
+{
+  size_t nrBytes = seen.length() * sizeof(State) +
+    hashCons2seen.length() * sizeof(int) +
+    successorCodes.length() +
+    fwdArcs.length() * sizeof(ArcMap*);
+  for (const PartialMap::value_type& p : partialStates)
+    nrBytes += sizeof(p) + p.second.nextStates.length() * sizeof(int);
+  if (stateStore != 0)
+    nrBytes += stateStore->getNrBytesInMemory();
+  if (fingerprints != 0)
+    nrBytes += fingerprints->getNrBytesUsed();
+  return nrBytes;
 }
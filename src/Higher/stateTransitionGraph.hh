@@ -29,8 +29,9 @@
 #include <map>
 #include "hashConsSet.hh"
 #include "rewritingContext.hh"
+#include "simpleRootContainer.hh"
 
-class StateTransitionGraph
+class StateTransitionGraph : private SimpleRootContainer
 {
   NO_COPYING(StateTransitionGraph);
 
@@ -50,35 +51,189 @@ public:
   RewritingContext* getContext();
   void transferCountTo(RewritingContext& recipient);
   int getStateParent(int stateNr) const;
+  //
+  //	Allow the successors of blocks of states to be computed in parallel
+  //	by a pool of worker processes.
+  //
+  void setExpansionPool(int nrProcesses, DagSerializer* serializer);
+  //
+  //	In compact mode we don't store the rules that label arcs; instead
+  //	they are recomputed when asked for.
+  //
+  static void setCompactMode(bool polarity);
+  static bool getCompactMode();
+  //
+  //	Keep state dags in a log file in the given directory rather than
+  //	in memory. This only affects graphs that call useStateStore() before
+  //	any exploration is done.
+  //
+  static void setStateStoreDirectory(const char* directory);
+  void useStateStore();
+  //
+  //	Identify states by 64-bit fingerprints (hash compaction) or by
+  //	bitstate hashing rather than keeping their dags; some states may be
+  //	missed. Bitstate hashing loses the identity of states that have
+  //	been seen before, so graphs that need it fall back to hash compaction.
+  //	Only affects graphs that call useStateHashing() before any
+  //	exploration is done.
+  //
+  static void setHashCompaction(bool polarity);
+  static void setBitstateHashing(int log2NrBits, int nrHashFunctions);
+  void useStateHashing(bool needStateIdentity);
+  bool usingStateHashing() const;
+  double getOmissionProbability() const;
+  //
+  //	Computing a state dag or arcs that are not held in memory involves
+  //	rewriting, and hence garbage collection. Callers that hold on to
+  //	unprotected dags while visiting a number of states should prefetch
+  //	them first; prefetched information is kept until the next call to
+  //	getNextState().
+  //
+  void prefetchState(int stateNr) const;
+  //
+  //	Memory used for the graph itself, not counting state dags.
+  //
+  size_t getNrBytesUsed() const;
 
 private:
+  enum Constants
+  {
+    UNEXPLORED = -1,		// successors not yet encoded
+    NR_CURSORS = 64,		// must be a power of 2
+    MAX_CACHED_STATES = 4096	// for dags and arcs not held in memory
+  };
+  //
+  //	Once a state is fully explored its successors are stored as a
+  //	count, followed by zig-zag encoded differences between each successor
+  //	and the previous one (starting with the state itself), each written
+  //	as a variable length integer in successorCodes.
+  //
   struct State
   {
     State(int hashConsIndex, int parent);
 
-    const int hashConsIndex;
-    const int parent;
+    int hashConsIndex;
+    int parent;
+    Int64 successors;		// offset into successorCodes or UNEXPLORED
+  };
+  //
+  //	Extra information for states that have been visited but not yet
+  //	fully explored.
+  //
+  struct PartialState
+  {
+    PartialState();
+
     Vector<int> nextStates;
     RewriteSearchState* rewriteState;
-    bool fullyExplored;
-    ArcMap fwdArcs;
+  };
+  typedef map<int, PartialState> PartialMap;
+  typedef map<int, DagNode*> DagMap;
+  typedef map<int, ArcMap> RecomputedArcMap;
+  //
+  //	Decoding position within the successors of a fully explored state;
+  //	we cache a few so that iterating over successors is cheap even when
+  //	the iterations for different states are interleaved.
+  //
+  struct Cursor
+  {
+    int stateNr;
+    int nrSuccessors;
+    int index;			// index of last successor decoded
+    int successor;		// last successor decoded
+    Int64 position;		// position of next code
   };
 
-  void insertNewState(int parent);
+  DagNode* computeNextSuccessor(int stateNr, Rule*& rule);
+  int addArc(int stateNr, DagNode* successor, Rule* rule);
+  int insertInHashConsSet(int stateNr, DagNode* successor);
+  void finishState(int stateNr);
+  bool isUntouched(int stateNr) const;
+  int getNrSuccessors(int stateNr) const;
+  int getSuccessor(int stateNr, int index) const;
+  Cursor& getCursor(int stateNr) const;
+  void appendCode(Uint64 code);
+  Uint64 readCode(Int64& position) const;
+  DagNode* materialize(int stateNr) const;
+  DagNode* replay(int stateNr) const;
+  DagNode* regenerate(DagNode* parentDag, int parentNr, int stateNr) const;
+  const ArcMap& recomputeArcs(int stateNr) const;
+  void flushCaches();
+  void markReachableNodes();
+
+  static bool compactMode;
+  static string stateStoreDirectory;
+  static bool hashCompaction;
+  static int bitstateLog2NrBits;
+  static int bitstateNrHashFunctions;
 
   RewritingContext* initial;
-  Vector<State*> seen;
+  Vector<State> seen;
   Vector<int> hashCons2seen;  // partial map of hashCons indices to state indices
   HashConsSet hashConsSet;
+  Vector<unsigned char> successorCodes;
+  PartialMap partialStates;
+  Vector<ArcMap*> fwdArcs;	// only used if not in compact mode
+  StateExpansionPool* expansionPool;
+  DiskStateStore* stateStore;
+  FingerprintTable* fingerprints;
+  DagMap unexploredDags;		// only used with state hashing
+  mutable Cursor cursors[NR_CURSORS];
+  mutable RecomputedArcMap recomputedArcs;	// only used in compact mode
+  mutable DagMap materializedDags;	// only used if we don't keep dags
+
+  friend class StateExpansionPool;
 };
 
 inline
 StateTransitionGraph::State::State(int hashConsIndex, int parent)
   : hashConsIndex(hashConsIndex),
     parent(parent)
+{
+  successors = UNEXPLORED;
+}
+
+inline
+StateTransitionGraph::PartialState::PartialState()
 {
   rewriteState = 0;
-  fullyExplored = false;
+}
+
+inline void
+StateTransitionGraph::setCompactMode(bool polarity)
+{
+  compactMode = polarity;
+}
+
+inline bool
+StateTransitionGraph::getCompactMode()
+{
+  return compactMode;
+}
+
+inline void
+StateTransitionGraph::setStateStoreDirectory(const char* directory)
+{
+  stateStoreDirectory = directory;
+}
+
+inline void
+StateTransitionGraph::setHashCompaction(bool polarity)
+{
+  hashCompaction = polarity;
+}
+
+inline void
+StateTransitionGraph::setBitstateHashing(int log2NrBits, int nrHashFunctions)
+{
+  bitstateLog2NrBits = log2NrBits;
+  bitstateNrHashFunctions = nrHashFunctions;
+}
+
+inline bool
+StateTransitionGraph::usingStateHashing() const
+{
+  return fingerprints != 0;
 }
 
 inline int
@@ -90,13 +245,8 @@ StateTransitionGraph::getNrStates() const
 inline DagNode*
 StateTransitionGraph::getStateDag(int stateNr) const
 {
-  return hashConsSet.getCanonical(seen[stateNr]->hashConsIndex);
-}
-
-inline const StateTransitionGraph::ArcMap&
-StateTransitionGraph::getStateFwdArcs(int stateNr) const
-{
-  return seen[stateNr]->fwdArcs;
+  return (stateStore == 0 && fingerprints == 0) ?
+    hashConsSet.getCanonical(seen[stateNr].hashConsIndex) : materialize(stateNr);
 }
 
 inline RewritingContext*
@@ -114,7 +264,43 @@ StateTransitionGraph::transferCountTo(RewritingContext& recipient)
 inline int
 StateTransitionGraph::getStateParent(int stateNr) const
 {
-  return seen[stateNr]->parent;
+  return seen[stateNr].parent;
+}
+
+inline bool
+StateTransitionGraph::isUntouched(int stateNr) const
+{
+  return seen[stateNr].successors == UNEXPLORED &&
+    partialStates.find(stateNr) == partialStates.end();
+}
+
+inline StateTransitionGraph::Cursor&
+StateTransitionGraph::getCursor(int stateNr) const
+{
+  Cursor& c = cursors[stateNr & (NR_CURSORS - 1)];
+  if (c.stateNr != stateNr)
+    {
+      c.stateNr = stateNr;
+      c.position = seen[stateNr].successors;
+      c.nrSuccessors = readCode(c.position);
+      c.index = NONE;
+      c.successor = stateNr;
+    }
+  return c;
+}
+
+inline Uint64
+StateTransitionGraph::readCode(Int64& position) const
+{
+  Uint64 code = 0;
+  for (int shift = 0;; shift += 7)
+    {
+      unsigned char byte = successorCodes[position++];
+      code |= static_cast<Uint64>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+	break;
+    }
+  return code;
 }
 
 #endif
@@ -43,6 +43,7 @@
 #include "argumentIterator.hh"
 #include "dagArgumentIterator.hh"
 #include "sortConstraint.hh"
+#include "sortInfoCache.hh"
 
 //
 //	This can't be local to a function because we're not allowed to
@@ -70,12 +71,66 @@ AssociativeSymbol::finalizeSortInfo()
   //
   //	These things are dependent on sort constraints and hence can't be done
   //	correctly until all sort constraints that could apply to our symbol
-  //	have been determined.
+  //	have been determined. They are also expensive for large kinds, so we
+  //	look for them in the module cache, keyed by our sort constraint sorts
+  //	as well as our declarations.
   //
-  associativeSortCheck();
-  associativeCtorCheck();
+  SortInfoCache* cache = SortInfoCache::getActive();
+  Uint64 fingerprint = 0;
+  if (cache != 0)
+    {
+      fingerprint = cache->fingerprint(this, SortInfoCache::ASSOCIATIVE_ANALYSIS);
+      for (const SortConstraint* sc : getSortConstraints())
+	fingerprint = SortInfoCache::mix(fingerprint, sc->getSort()->index());
+      const Vector<int>* record = cache->find(fingerprint);
+      if (record != 0 && restoreAssociativeAnalysis(*record))
+	return;
+    }
+  bool clean = associativeSortCheck();
+  if (!associativeCtorCheck())
+    clean = false;
   associativeSortBoundsAnalysis();
   associativeSortStructureAnalysis();
+  if (cache != 0 && clean)
+    {
+      Vector<int> record;
+      saveAssociativeAnalysis(record);
+      cache->insert(fingerprint, record);
+    }
+}
+
+void
+AssociativeSymbol::saveAssociativeAnalysis(Vector<int>& record) const
+{
+  //
+  //	Layout is uniSort index (0 if none) followed by the bound and
+  //	structure for each sort in our kind.
+  //
+  record.append(uniSort == 0 ? 0 : uniSort->index());
+  int nrSorts = sortBounds.size();
+  for (int i = 0; i < nrSorts; ++i)
+    {
+      record.append(sortBounds[i]);
+      record.append(sortStructures[i]);
+    }
+}
+
+bool
+AssociativeSymbol::restoreAssociativeAnalysis(const Vector<int>& record)
+{
+  const ConnectedComponent* component = rangeComponent();
+  int nrSorts = component->nrSorts();
+  if (record.size() != 1 + 2 * nrSorts || record[0] < 0 || record[0] >= nrSorts)
+    return false;
+  uniSort = (record[0] == 0) ? 0 : component->sort(record[0]);
+  sortBounds.resize(nrSorts);
+  sortStructures.resize(nrSorts);
+  for (int i = 0; i < nrSorts; ++i)
+    {
+      sortBounds[i] = record[1 + 2 * i];
+      sortStructures[i] = static_cast<Structure>(record[2 + 2 * i]);
+    }
+  return true;
 }
 
 void
@@ -131,7 +186,7 @@ AssociativeSymbol::checkUniformity(const Sort* uniformSort, int nrSorts)
   return true;
 }
 
-void
+bool
 AssociativeSymbol::associativeSortCheck()
 {
   const ConnectedComponent* component = rangeComponent();
@@ -141,8 +196,9 @@ AssociativeSymbol::associativeSortCheck()
   uniSort = 0;
 
   if (kindLevelDeclarationsOnly())
-    return;
-  WarningCheck(getSortConstraints().empty(),
+    return true;
+  bool clean = getSortConstraints().empty();
+  WarningCheck(clean,
 	       "membership axioms are not guaranteed to work correctly for associative symbol " <<
 	       QUOTE(this) << " as it has declarations that are not at the kind level.");
 
@@ -157,7 +213,7 @@ AssociativeSymbol::associativeSortCheck()
   if (candidate != 0 && checkUniformity(candidate, nrSorts))
     {
       uniSort = candidate;
-      return;
+      return clean;
     }
   //
   //   Sort table is not uniform so check all triples to see if it is associative.
@@ -224,6 +280,7 @@ AssociativeSymbol::associativeSortCheck()
 	       QUOTE(component->sort(bad1)) << ", " << 
 	       QUOTE(component->sort(bad2)) << ", " << 
 	       QUOTE(component->sort(bad3)) << ").");
+  return clean && nrBadTriples == 0;
 }
 
 #if 0
@@ -276,11 +333,11 @@ AssociativeSymbol::associativeCtorCheck()
 
 #else
 
-void
+bool
 AssociativeSymbol::associativeCtorCheck()
 {
   if (getCtorStatus() != SortTable::IS_COMPLEX)
-    return;  // trivial case - either all constructors or all non-constructors
+    return true;  // trivial case - either all constructors or all non-constructors
   //
   //	In order for all members of a congruence class to have the same ctor it is necessary and
   //	sufficient (as long as s_f is associative) that:
@@ -368,6 +425,7 @@ AssociativeSymbol::associativeCtorCheck()
 	       QUOTE(component->sort(bad1)) << ", " << 
 	       QUOTE(component->sort(bad2)) << ", " << 
 	       QUOTE(component->sort(bad3)) << ").");
+  return nrBadTriples == 0;
 }
 
 #endif
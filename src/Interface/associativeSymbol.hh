@@ -67,12 +67,14 @@ protected:
 private:
   struct Inv;
 
-  void associativeSortCheck();
-  void associativeCtorCheck();
+  bool associativeSortCheck();
+  bool associativeCtorCheck();
   void associativeSortBoundsAnalysis();
   void associativeSortStructureAnalysis();
   bool checkUniformity(const Sort* uniformSort, int nrSorts);
   void insertGreaterOrEqualSorts(const Sort* sort, NatSet& set);
+  void saveAssociativeAnalysis(Vector<int>& record) const;
+  bool restoreAssociativeAnalysis(const Vector<int>& record);
 
   const Sort* uniSort;
   Vector<int> sortBounds;
@@ -254,6 +254,8 @@ private:
     Symbol* topSymbol;
     DagNode* copyPointer;
   };
+
+  friend class ParallelMarker;	// to call markArguments()
 };
 
 #define SAFE_INSTANTIATE(dagNode, eagerFlag, substitution, eagerCopies) \
@@ -396,6 +398,7 @@ DagNode::operator new(size_t /* size */, DagNode* old)
   if (old->getMemoryInfo()->needToCallDtor())
     old->~DagNode();  // explicitly call virtual destructor on replaced DagNode
   old->getMemoryInfo()->clearAllExceptMarked();
+  MemoryCell::writeBarrier(old);
   return old;
 }
 
@@ -559,6 +562,8 @@ DagNode::mark()
   Assert(topSymbol->arity() >= 0 &&
 	 topSymbol->arity() <= 30,  // arbitrary - but helps catch bugs
 	 "bad symbol at " << static_cast<void*>(topSymbol));
+  if (MemoryCell::deferMark(this))
+    return;  // parallel mark phase
   DagNode* d = this;
   while (!(d->getMemoryInfo()->isMarked()))
     {
@@ -58,10 +58,10 @@
 #include "compilationContext.hh"
 #include "variableName.hh"
 
-Vector<DagNode*> Term::subDags;
-TermSet Term::converted;
-bool Term::setSortInfoFlag;
-bool Term::discard;
+thread_local Vector<DagNode*> Term::subDags;
+thread_local TermSet Term::converted;
+thread_local bool Term::setSortInfoFlag;
+thread_local bool Term::discard;
 
 DagNode*
 Term::term2Dag(bool setSortInfo)
@@ -38,7 +38,7 @@ class Term : public LineNumber
 {
   NO_COPYING(Term);
 
-  static bool discard;
+  static thread_local bool discard;
 
 public:
   enum ReturnValues
@@ -258,9 +258,12 @@ private:
   static bool commonWithOtherPatterns(Vector<Term*>& patterns, int excluded, Symbol* symbol);
   static bool hasGeqOrIncomparableVariable(Term* pattern, VariableSymbol* v);
 
-  static Vector<DagNode*> subDags;
-  static TermSet converted;
-  static bool setSortInfoFlag;
+  //
+  //	Per thread so that terms can be converted to dags concurrently.
+  //
+  static thread_local Vector<DagNode*> subDags;
+  static thread_local TermSet converted;
+  static thread_local bool setSortInfoFlag;
 
   Symbol* topSymbol;
   NatSet occursSet;
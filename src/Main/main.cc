@@ -24,6 +24,7 @@
 //	main() function and misc functions.
 //
 #include "sys/param.h"
+#include <sys/stat.h>
 #ifdef ALPHA
 #include <stropts.h>
 #endif
@@ -36,12 +37,14 @@
 
 
 //      forward declarations
+#include "temporal.hh"
 #include "interface.hh"
 #include "core.hh"
 #include "higher.hh"
 #include "freeTheory.hh"
 #include "builtIn.hh"
 #include "objectSystem.hh"
+#include "meta.hh"
 #include "strategyLanguage.hh"
 #include "mixfix.hh"
  
@@ -50,10 +53,19 @@
  
 //      core class definitions
 #include "lineNumber.hh"
+#include "memoryCell.hh"
+#include "largePageAllocator.hh"
+#include "rewritingContext.hh"
+#include "sortInfoCache.hh"
+#include "parallelMatcher.hh"
 
 //      built class definitions
 #include "randomOpSymbol.hh"
 
+//      higher class definitions
+#include "modelCheckerSymbol.hh"
+#include "stateTransitionGraph.hh"
+
 //      object system class definitions
 #include "processManagerSymbol.hh"
 #include "fileManagerSymbol.hh"
@@ -65,6 +77,8 @@
 //	mixfix frontend definitions
 #include "token.hh"
 #include "userLevelRewritingContext.hh"
+#include "objectSystemRewritingContext.hh"
+#include "interpreterManagerSymbol.hh"
 #include "fileTable.hh"
 #include "directoryManager.hh"
 #include "mixfixModule.hh"
@@ -84,6 +98,7 @@ main(int argc, char* argv[])
   bool includeFile(const string& directory, const string& fileName, bool silent, int lineNr);
   extern Vector<char*> pendingFiles;
   const char* isFlag(const char* arg, const char* flag);
+  bool isSize(const char* s, size_t& size);
   bool findExecutableDirectory(string& directory, string& executable);
   bool findPrelude(string& directory, string& fileName);
   void checkForPending();
@@ -93,6 +108,8 @@ main(int argc, char* argv[])
   bool readPrelude = true;
   bool forceInteractive = false;
   bool outputBanner = true;
+  int bitstateLog2NrBits = 0;
+  int bitstateNrHashFunctions = 3;
   int ansiColor = UNDECIDED;
   int useTecla = UNDECIDED;
  
@@ -117,6 +134,175 @@ main(int argc, char* argv[])
 			       ": bad associative unification depth value: " << QUOTE(s));
 		}
 	    }
+	  else if (const char* s = isFlag(arg, "-search-processes="))
+	    {
+	      char *endptr;
+	      long n = strtol(s, &endptr, 10);
+	      if (endptr > s && *endptr == '\0' && n >= 1 && n <= 256)
+		interpreter.setNrSearchProcesses(n);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad number of search processes: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-model-checker-processes="))
+	    {
+	      char *endptr;
+	      long n = strtol(s, &endptr, 10);
+	      if (endptr > s && *endptr == '\0' && n >= 1 && n <= 256)
+		ModelCheckerSymbol::setNrProcesses(n);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad number of model checker processes: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-state-store-dir="))
+	    StateTransitionGraph::setStateStoreDirectory(s);
+	  else if (const char* s = isFlag(arg, "-bitstate="))
+	    {
+	      char *endptr;
+	      long n = strtol(s, &endptr, 10);
+	      if (endptr > s && *endptr == '\0' && n >= 10 && n <= 40)
+		bitstateLog2NrBits = n;
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad log2 bitstate table size: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-bitstate-hashes="))
+	    {
+	      char *endptr;
+	      long n = strtol(s, &endptr, 10);
+	      if (endptr > s && *endptr == '\0' && n >= 1 && n <= 16)
+		bitstateNrHashFunctions = n;
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad number of bitstate hash functions: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-gc-threads="))
+	    {
+	      char *endptr;
+	      long n = strtol(s, &endptr, 10);
+	      if (endptr > s && *endptr == '\0' && n >= 1 && n <= 256)
+		MemoryCell::setNrGcThreads(n);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad number of garbage collector threads: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-gc-initial-heap="))
+	    {
+	      size_t size;
+	      if (isSize(s, size))
+		MemoryCell::setInitialHeapSize(size);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad initial heap size: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-gc-growth="))
+	    {
+	      char *endptr;
+	      double g = strtod(s, &endptr);
+	      if (endptr > s && *endptr == '\0' && isfinite(g) && g >= 1.1 && g <= 100.0)
+		MemoryCell::setGrowthFactor(g);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad heap growth factor: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-gc-max-heap="))
+	    {
+	      size_t size;
+	      if (isSize(s, size) && size > 0)
+		MemoryCell::setMaxHeapSize(size);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad maximum heap size: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-huge-pages="))
+	    {
+	      if (strcmp(s, "transparent") == 0)
+		LargePageAllocator::setPageMode(LargePageAllocator::TRANSPARENT_HUGE_PAGES);
+	      else if (strcmp(s, "explicit") == 0)
+		LargePageAllocator::setPageMode(LargePageAllocator::EXPLICIT_HUGE_PAGES);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad huge page mode: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-numa="))
+	    {
+	      if (strcmp(s, "interleave") == 0)
+		LargePageAllocator::setNumaPolicy(LargePageAllocator::INTERLEAVE_NUMA);
+	      else if (strcmp(s, "local") == 0)
+		LargePageAllocator::setNumaPolicy(LargePageAllocator::LOCAL_NUMA);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad NUMA policy: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-interpreter-pool="))
+	    {
+	      char *endptr;
+	      long n = strtol(s, &endptr, 10);
+	      if (endptr > s && *endptr == '\0' && n >= 0 && n <= 256)
+		InterpreterManagerSymbol::setPoolSize(n);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad interpreter pool size: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-frewrite-threads="))
+	    {
+	      char *endptr;
+	      long n = strtol(s, &endptr, 10);
+	      if (endptr > s && *endptr == '\0' && n >= 1 && n <= 256)
+		RewritingContext::setNrFairThreads(n);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad number of fair rewriting threads: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-search-match-threads="))
+	    {
+	      char *endptr;
+	      long n = strtol(s, &endptr, 10);
+	      if (endptr > s && *endptr == '\0' && n >= 1 && n <= 256)
+		ParallelMatcher::setNrThreads(n);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": bad number of search matching threads: " << QUOTE(s));
+		}
+	    }
+	  else if (const char* s = isFlag(arg, "-module-cache="))
+	    {
+	      struct stat info;
+	      if (stat(s, &info) == 0 && S_ISDIR(info.st_mode))
+		SortInfoCache::setDirectory(s);
+	      else
+		{
+		  IssueWarning(LineNumber(FileTable::COMMAND_LINE) <<
+			       ": module cache " << QUOTE(s) << " is not a directory.");
+		}
+	    }
+	  else if (strcmp(arg, "-text-serialization") == 0)
+	    MixfixModule::setTextSerialization(true);
 	  else if (strcmp(arg, "--help") == 0)
 	    printHelp(argv[0]);
 	  else if (strcmp(arg, "--version") == 0)
@@ -155,6 +341,12 @@ main(int argc, char* argv[])
 	    UserLevelRewritingContext::setPrintAttributeStream(&cerr);
 	  else if (strcmp(arg, "-show-pid") == 0)
 	    cerr << getpid() << endl;
+	  else if (strcmp(arg, "-compact-states") == 0)
+	    StateTransitionGraph::setCompactMode(true);
+	  else if (strcmp(arg, "-hash-compaction") == 0)
+	    StateTransitionGraph::setHashCompaction(true);
+	  else if (strcmp(arg, "-generational-gc") == 0)
+	    MemoryCell::setGenerational(true);
 	  else if (strcmp(arg, "-erewrite-loop-mode") == 0)
 	    interpreter.setFlag(Interpreter::EREWRITE_LOOP_MODE, true);
 	  else if (strcmp(arg, "-allow-processes") == 0)
@@ -178,6 +370,8 @@ main(int argc, char* argv[])
       else
 	pendingFiles.append(arg);
     }
+  if (bitstateLog2NrBits > 0)
+    StateTransitionGraph::setBitstateHashing(bitstateLog2NrBits, bitstateNrHashFunctions);
 
   //
   //	We pass all output to terminal through wrapping code to
@@ -270,6 +464,41 @@ isFlag(const char* arg, const char* flag)
   return 0;
 }
 
+bool
+isSize(const char* s, size_t& size)
+{
+  //
+  //	A number of bytes with an optional K, M or G suffix.
+  //
+  char *endptr;
+  unsigned long long n = strtoull(s, &endptr, 10);
+  if (endptr == s || *s == '-')
+    return false;
+  int shift = 0;
+  switch (*endptr)
+    {
+    case 'K':
+    case 'k':
+      shift = 10;
+      ++endptr;
+      break;
+    case 'M':
+    case 'm':
+      shift = 20;
+      ++endptr;
+      break;
+    case 'G':
+    case 'g':
+      shift = 30;
+      ++endptr;
+      break;
+    }
+  if (*endptr != '\0' || n > (static_cast<unsigned long long>(SIZE_MAX) >> shift))
+    return false;
+  size = n << shift;
+  return true;
+}
+
 void
 printHelp(const char* name)
 {
@@ -300,7 +529,26 @@ printHelp(const char* name)
     "  -allow-files\t\tAllow operations on files\n" <<
     "  -allow-dir\t\tAllow operations on directories\n" <<
     "  -trust\t\tAllow all potentially risky capabilities\n" <<
-    "  -assoc-unif-depth=<float>\tSet depth bound multiplier for associative unification\n"
+    "  -assoc-unif-depth=<float>\tSet depth bound multiplier for associative unification\n" <<
+    "  -search-processes=<int>\tUse worker processes to expand states in search\n" <<
+    "  -model-checker-processes=<int>\tUse a swarm of worker processes for model checking\n" <<
+    "  -compact-states\tUse less memory per state in search and model checking\n" <<
+    "  -state-store-dir=<dir>\tKeep search and model checking states on disk in <dir>\n" <<
+    "  -hash-compaction\tIdentify search and model checking states by 64-bit fingerprints\n" <<
+    "  -bitstate=<int>\tUse a bitstate table of 2^<int> bits for search\n" <<
+    "  -bitstate-hashes=<int>\tSet number of hash functions for bitstate search\n" <<
+    "  -generational-gc\tUse minor collections of recently allocated nodes\n" <<
+    "  -gc-threads=<int>\tSet number of threads used to mark reachable nodes\n" <<
+    "  -gc-initial-heap=<size>\tSet heap size before first garbage collection\n" <<
+    "  -gc-growth=<number>\tSet heap growth factor after garbage collection\n" <<
+    "  -gc-max-heap=<size>\tAbort commands whose live data exceeds <size>\n" <<
+    "  -huge-pages=<mode>\tBack heap with transparent or explicit huge pages\n" <<
+    "  -numa=<policy>\tPlace heap pages with interleave or local NUMA policy\n" <<
+    "  -frewrite-threads=<int>\tSet number of threads used by frewrite on independent subterms\n" <<
+    "  -search-match-threads=<int>\tSet number of threads used by search to match against large AC subjects\n" <<
+    "  -module-cache=<dir>\tKeep sort computations for modules in <dir> between runs\n" <<
+    "  -text-serialization\tSend dags to other processes in readable text format\n" <<
+    "  -interpreter-pool=<int>\tKeep <int> idle processes for remote interpreters\n" <<
     "\n" <<
     "Send bug reports to: " << PACKAGE_BUGREPORT << endl;
   exit(0);
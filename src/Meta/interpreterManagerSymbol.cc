@@ -118,6 +118,8 @@
 #include "miNarrow.cc"
 #include "miNarrowSearch.cc"
 
+int InterpreterManagerSymbol::poolSize = 0;
+
 InterpreterManagerSymbol::InterpreterManagerSymbol(int id)
   : ExternalObjectManagerSymbol(id)
 {
@@ -131,6 +133,7 @@ InterpreterManagerSymbol::InterpreterManagerSymbol(int id)
 
 InterpreterManagerSymbol::~InterpreterManagerSymbol()
 {
+  drainPool();
   if (shareWith == 0)
     delete metaLevel;
 }
@@ -390,6 +393,12 @@ InterpreterManagerSymbol::deleteInterpreter(DagNode* interpreterArg)
 		  if (i != remoteInterpreters.end())
 		    {
 		      DebugInfo("deleted remote interpreter " << interpreterArg);
+		      if (recycle(i->second))
+			{
+			  DebugInfo("recycled process " << i->second.processId);
+			  remoteInterpreters.erase(i);
+			  return true;
+			}
 		      {
 			int fd = i->second.ioSocket;
 			DebugInfo("closing i/o socket " << fd);
@@ -410,7 +419,6 @@ InterpreterManagerSymbol::deleteInterpreter(DagNode* interpreterArg)
 		      //	Wait for child we just terminated to avoid a zombie.
 		      //
 		      waitpid(i->second.processId, 0, 0);
-		      delete i->second.charArray;
 		      remoteInterpreters.erase(i);
 		      return true;
 		    }
@@ -472,13 +480,18 @@ InterpreterManagerSymbol::createInterpreter(FreeDagNode* originalMessage,
 
 DagNode*
 InterpreterManagerSymbol::upRewriteCount(const RewritingContext* context)
+{
+  return upRewriteCount(context->getTotalCount());
+}
+
+DagNode*
+InterpreterManagerSymbol::upRewriteCount(Int64 count)
 {
 #if SIZEOF_LONG == 8
-  mpz_class totalCount(context->getTotalCount());
+  mpz_class totalCount(count);
 #else
-  Int64 totalCount64 = context->getTotalCount();
   mpz_class totalCount;
-  mpz_import(totalCount.get_mpz_t(), 1, 1, sizeof(totalCount64), 0, 0, &totalCount64);
+  mpz_import(totalCount.get_mpz_t(), 1, 1, sizeof(count), 0, 0, &count);
 #endif
   return metaLevel->upNat(totalCount);
 }
@@ -60,6 +60,14 @@ public:
   bool handleManagerMessage(DagNode* message, ObjectSystemRewritingContext& context);
   bool handleMessage(DagNode* message, ObjectSystemRewritingContext& context);
   void cleanUp(DagNode* objectId);
+  //
+  //	Keep up to this many idle remote interpreter processes, either
+  //	forked in advance or recycled after their interpreter was deleted,
+  //	so that creating a remote interpreter need not fork. A recycled
+  //	process keeps the modules inserted by its previous users so that
+  //	inserting an identical module again is cheap.
+  //
+  static void setPoolSize(int size);
 
 private:
   struct RemoteInterpreter
@@ -68,16 +76,20 @@ private:
     int ioSocket;
     int errSocket;
     //
-    //	To handle nonblocking send.
+    //	To handle nonblocking send; frames queue up here until the
+    //	socket will take them.
     //
-    char* charArray;  // full message
-    const char* unsent;  // point to first unsent character
-    Rope::size_type nrUnsent;  // number of unsent characters
+    string outgoingFrames;
+    size_t nrBytesSent;  // characters at the front of outgoingFrames already sent
     //
-    //	To handle async replies from remote interpreter.
+    //	To handle async replies from remote interpreter. Characters are
+    //	read straight into incomingFrames, which is grown to hold the
+    //	whole of a frame once its length is known, and each reply is
+    //	deserialized where it lies.
     //
     int nrPendingReplies;
-    Rope incomingMessage;
+    string incomingFrames;
+    size_t nrBytesReceived;  // characters at the front of incomingFrames holding data
     Rope incomingErrorLine;
     ObjectSystemRewritingContext* savedContext;
     MixfixModule* module;
@@ -90,6 +102,25 @@ private:
   };
 
   typedef map<int, RemoteInterpreter> RemoteInterpreterMap;
+  //
+  //	An idle remote interpreter process.
+  //
+  struct RemoteProcess
+  {
+    pid_t processId;
+    int ioSocket;
+    int errSocket;
+  };
+  //
+  //	Messages between parent and remote interpreter are each preceded
+  //	by their length so that serialized dags may contain any byte.
+  //
+  typedef Uint64 FrameLength;
+
+  enum TransportParameters
+  {
+    MAX_IDLE_READ_BUFFER = 4 * READ_BUFFER_SIZE	// shrink receive buffer if bigger than this when empty
+  };
 
   //
   //	Overridden methods from PseudoThread.
@@ -141,14 +172,24 @@ private:
 			       ObjectSystemRewritingContext& context,
 			       int id);
   RemoteInterpreter* getRemoteInterpreter(DagNode* interpreterArg);
+  int forkRemoteInterpreter(MixfixModule* m,
+			    ObjectSystemRewritingContext& context,
+			    RemoteProcess& process);
+  bool takeFromPool(RemoteProcess& process);
+  void fillPool(MixfixModule* m, ObjectSystemRewritingContext& context);
+  bool recycle(RemoteInterpreter& ri);
+  void drainPool();
   bool remoteHandleMessage(FreeDagNode* message,
 			   ObjectSystemRewritingContext& context,
 			   RemoteInterpreter* r);
-  void remoteHandleReply(RemoteInterpreter* r, const Rope& reply);
+  void remoteHandleReply(RemoteInterpreter* r, const char* reply, size_t length);
 
-  void nonblockingSendMessage(RemoteInterpreter& ri, const Rope& message);
-  Rope receiveMessage(int socketId);
-  void sendMessage(int socketId, const Rope& message);
+  static void appendFrame(string& buffer, MixfixModule* m, DagNode* message);
+  void nonblockingSendMessage(RemoteInterpreter& ri, DagNode* message);
+  bool writeOutgoingFrames(RemoteInterpreter& ri, bool mightBlock);
+  static void receiveBytes(int socketId, char* destination, size_t nrBytes);
+  void receiveMessage(int socketId, string& message);
+  void sendMessage(int socketId, const string& frames);
   bool outputWholeErrorLines(RemoteInterpreter* ri);
   
   void becomeRemoteInterpreter(int socketId,
@@ -164,6 +205,7 @@ private:
   DagNode* getMetaModule(FreeDagNode* message,
 			 Interpreter* interpreter,
 			 MetaModule*& mm);
+  bool alreadyInserted(DagNode* metaModule, Interpreter* interpreter);
   DagNode* insertModule(FreeDagNode* message,
 			ObjectSystemRewritingContext& context,
 			Interpreter* interpreter);
@@ -209,6 +251,18 @@ private:
   DagNode* rewriteTerm(FreeDagNode* message,
 		       ObjectSystemRewritingContext& context,
 		       Interpreter* interpreter);
+  DagNode* reduceTerms(FreeDagNode* message,
+		       ObjectSystemRewritingContext& context,
+		       Interpreter* interpreter);
+  DagNode* rewriteTerms(FreeDagNode* message,
+			ObjectSystemRewritingContext& context,
+			Interpreter* interpreter);
+  DagNode* rewriteTermBatch(FreeDagNode* message,
+			    ObjectSystemRewritingContext& context,
+			    MetaModule* m,
+			    const Vector<Term*>& terms,
+			    bool useRules,
+			    Int64 limit);
   DagNode* frewriteTerm(FreeDagNode* message,
 			ObjectSystemRewritingContext& context,
 			Interpreter* interpreter);
@@ -260,6 +314,7 @@ private:
 				    bool returnPath,
 				    Interpreter* interpreter);
   DagNode* upRewriteCount(const RewritingContext* context);
+  DagNode* upRewriteCount(Int64 count);
   void errorReply(const Rope& errorMessage,
 		  FreeDagNode* originalMessage,
 		  ObjectSystemRewritingContext& context);
@@ -277,8 +332,17 @@ private:
 
   Vector<Interpreter*> interpreters;
   RemoteInterpreterMap remoteInterpreters;
+  Vector<RemoteProcess> idleProcesses;
+
+  static int poolSize;
 };
 
+inline void
+InterpreterManagerSymbol::setPoolSize(int size)
+{
+  poolSize = size;
+}
+
 inline RewritingContext*
 InterpreterManagerSymbol::term2RewritingContext(Term* term, RewritingContext& context)
 {
@@ -68,6 +68,10 @@
   MACRO(reducedTermMsg, FreeSymbol, 5)
   MACRO(rewriteTermMsg, FreeSymbol, 5)
   MACRO(rewroteTermMsg, FreeSymbol, 5)
+  MACRO(reduceTermsMsg, FreeSymbol, 5)
+  MACRO(reducedTermsMsg, FreeSymbol, 6)
+  MACRO(rewriteTermsMsg, FreeSymbol, 6)
+  MACRO(rewroteTermsMsg, FreeSymbol, 6)
   MACRO(frewriteTermMsg, FreeSymbol, 6)
   MACRO(frewroteTermMsg, FreeSymbol, 5)
   MACRO(erewriteTermMsg, FreeSymbol, 6)
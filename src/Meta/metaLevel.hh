@@ -57,7 +57,7 @@ public:
   void reset();
 
   bool isNat(const DagNode* dagNode) const;
-  const mpz_class& getNat(const DagNode* dagNode) const;
+  mpz_class getNat(const DagNode* dagNode) const;
 
   void startVariableMapping(int varCounter, FreshVariableGenerator* varGenerator);
   void stopVariableMapping();
@@ -237,6 +237,13 @@ public:
 		     MixfixModule* m,
 		     PointerMap& qidMap,
 		     PointerMap& dagNodeMap);
+  DagNode* upDagNodeList(const Vector<DagNode*>& dagNodes,
+			 MixfixModule* m,
+			 PointerMap& qidMap,
+			 PointerMap& dagNodeMap);
+  DagNode* upTypeList(const Vector<Sort*>& types,
+		      bool omitLast,
+		      PointerMap& qidMap);
   DagNode* upTypeListSet(const Vector<OpDeclaration>& opDecls,
 			 const NatSet& chosenDecls,
 			 PointerMap& qidMap);
@@ -520,10 +527,6 @@ private:
 		       PointerMap& qidMap,
 		       PointerMap& dagNodeMap);
 
-  DagNode* upTypeList(const Vector<Sort*>& types,
-		      bool omitLast,
-		      PointerMap& qidMap);
-
   DagNode* upSmtSubstitution(const Substitution& substitution,
 			     const VariableInfo& variableInfo,
 			     const NatSet& smtVariables,
@@ -698,7 +701,7 @@ MetaLevel::isNat(const DagNode* dagNode) const
   return succSymbol->isNat(dagNode);
 }
 
-inline const mpz_class&
+inline mpz_class
 MetaLevel::getNat(const DagNode* dagNode) const
 {
   return succSymbol->getNat(dagNode);
@@ -661,6 +661,9 @@ MetaLevel::upTrace(const RewriteSequenceSearch& state, MixfixModule* m)
   if (nrSteps == 0)
     return nilTraceSymbol->makeDagNode();
 
+  for (int stateNr : steps)
+    state.prefetchState(state.getStateParent(stateNr));
+
   Vector<DagNode*> args(nrSteps);
   PointerMap qidMap;
   PointerMap dagNodeMap;
@@ -781,6 +784,18 @@ MetaLevel::upQidList(const Vector<int>& ids, PointerMap& qidMap)
   return qidListSymbol->makeDagNode(args);
 }
 
+DagNode*
+MetaLevel::upDagNodeList(const Vector<DagNode*>& dagNodes,
+			 MixfixModule* m,
+			 PointerMap& qidMap,
+			 PointerMap& dagNodeMap)
+{
+  Vector<DagNode*> args;
+  for (DagNode* d : dagNodes)
+    args.append(upDagNode(d, m, qidMap, dagNodeMap));
+  return upGroup(args, emptyTermListSymbol, metaArgSymbol);
+}
+
 DagNode*
 MetaLevel::upTypeListSet(const Vector<OpDeclaration>& opDecls,
 			 const NatSet& chosenDecls,
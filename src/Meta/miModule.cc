@@ -65,6 +65,13 @@ InterpreterManagerSymbol::insertModule(FreeDagNode* message,
 				       Interpreter* interpreter)
 {
   DagNode* metaModule = message->getArgument(2);
+  if (alreadyInserted(metaModule, interpreter))
+    {
+      Vector<DagNode*> reply(2);
+      reply[0] = message->getArgument(1);
+      reply[1] = message->getArgument(0);
+      return insertedModuleMsg->makeDagNode(reply);
+    }
   //
   //	We create the flattened module first. Only if it is
   //	successful do we create the MetaPreModule and insert it in
@@ -100,6 +107,27 @@ InterpreterManagerSymbol::insertModule(FreeDagNode* message,
   return makeErrorReply("Bad module.", message);
 }
 
+bool
+InterpreterManagerSymbol::alreadyInserted(DagNode* metaModule, Interpreter* interpreter)
+{
+  //
+  //	An identical module that is still usable may have been inserted by
+  //	an earlier request, perhaps from a previous user of a recycled
+  //	remote interpreter; if so we keep it rather than compiling it again.
+  //
+  FreeDagNode* f = dynamic_cast<FreeDagNode*>(metaModule);
+  if (f == 0 || f->symbol()->arity() == 0)
+    return false;
+  int id;
+  DagNode* metaParameterDeclList;
+  if (!(metaLevel->downHeader(f->getArgument(0), id, metaParameterDeclList)))
+    return false;
+  MetaPreModule* pm = dynamic_cast<MetaPreModule*>(interpreter->getModule(id));
+  return pm != 0 &&
+    pm->getMetaRepresentation()->equal(metaModule) &&
+    pm->getFlatModule() != 0;
+}
+
 DagNode*
 InterpreterManagerSymbol::showModule(FreeDagNode* message,
 				     ObjectSystemRewritingContext& context,
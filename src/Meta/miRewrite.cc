@@ -22,7 +22,8 @@
 
 //
 //      MetaInterpreters: reduceTerm()/rewriteTerm()/frewriteTerm()/
-//	erewriteTerm()/srewriteTerm() messages.
+//	erewriteTerm()/srewriteTerm() messages and their batched
+//	reduceTerms()/rewriteTerms() forms.
 //
 
 DagNode*
@@ -104,6 +105,107 @@ InterpreterManagerSymbol::rewriteTerm(FreeDagNode* message,
   return makeErrorReply("Bad limit.", message);
 }
 
+DagNode*
+InterpreterManagerSymbol::reduceTerms(FreeDagNode* message,
+				      ObjectSystemRewritingContext& context,
+				      Interpreter* interpreter)
+{
+  //
+  //	op reduceTerms : Oid Oid Nat Qid TermList -> Msg .
+  //
+  DagNode* errorMessage;
+  if (MetaModule* m = getMetaModule(message, 3, interpreter, errorMessage))
+    {
+      Vector<Term*> terms;
+      if (metaLevel->downTermList(message->getArgument(4), m, terms))
+	return rewriteTermBatch(message, context, m, terms, false, 0);
+      return makeErrorReply("Bad term.", message);
+    }
+  return errorMessage;
+}
+
+DagNode*
+InterpreterManagerSymbol::rewriteTerms(FreeDagNode* message,
+				       ObjectSystemRewritingContext& context,
+				       Interpreter* interpreter)
+{
+  //
+  //	op rewriteTerms : Oid Oid Nat Bound Qid TermList -> Msg .
+  //
+  Int64 limit;
+  if (metaLevel->downBound64(message->getArgument(3), limit))
+    {
+      DagNode* errorMessage;
+      if (MetaModule* m = getMetaModule(message, 4, interpreter, errorMessage))
+	{
+	  Vector<Term*> terms;
+	  if (metaLevel->downTermList(message->getArgument(5), m, terms))
+	    return rewriteTermBatch(message, context, m, terms, true, limit);
+	  return makeErrorReply("Bad term.", message);
+	}
+      return errorMessage;
+    }
+  return makeErrorReply("Bad limit.", message);
+}
+
+DagNode*
+InterpreterManagerSymbol::rewriteTermBatch(FreeDagNode* message,
+					   ObjectSystemRewritingContext& context,
+					   MetaModule* m,
+					   const Vector<Term*>& terms,
+					   bool useRules,
+					   Int64 limit)
+{
+  //
+  //	Each term gets its own subcontext, and all of them are rewritten
+  //	before any result is moved up to the metalevel, since the
+  //	subcontexts are what keeps the earlier results safe from garbage
+  //	collections during later rewriting.
+  //
+  Vector<RewritingContext*> objectContexts;
+  for (Term* t : terms)
+    objectContexts.append(term2RewritingContext(t, context));
+  m->protect();
+  Int64 totalCount = 0;
+  for (RewritingContext* objectContext : objectContexts)
+    {
+      if (useRules)
+	{
+	  m->resetRules();
+	  objectContext->ruleRewrite(limit);
+	}
+      else
+	objectContext->reduce();
+      context.addInCount(*objectContext);
+      totalCount += objectContext->getTotalCount();
+    }
+
+  Vector<DagNode*> results;
+  Vector<Sort*> types;
+  for (RewritingContext* objectContext : objectContexts)
+    {
+      DagNode* dagNode = objectContext->root();
+      results.append(dagNode);
+      types.append(dagNode->getSort());
+    }
+
+  Vector<DagNode*> reply(6);
+  DagNode* target = message->getArgument(1);
+  reply[0] = target;
+  reply[1] = message->getArgument(0);
+  reply[2] = message->getArgument(2);  // correlation id is just echoed
+  reply[3] = upRewriteCount(totalCount);
+
+  PointerMap qidMap;
+  PointerMap dagNodeMap;
+  reply[4] = metaLevel->upDagNodeList(results, m, qidMap, dagNodeMap);
+  reply[5] = metaLevel->upTypeList(types, false, qidMap);
+  for (RewritingContext* objectContext : objectContexts)
+    delete objectContext;
+  (void) m->unprotect();
+  return (useRules ? rewroteTermsMsg : reducedTermsMsg)->makeDagNode(reply);
+}
+
 DagNode*
 InterpreterManagerSymbol::frewriteTerm(FreeDagNode* message,
 				       ObjectSystemRewritingContext& context,
@@ -84,20 +84,17 @@ InterpreterManagerSymbol::makeErrorReply(const Rope& errorMessage,
   return interpreterErrorMsg->makeDagNode(reply);
 }
 
-bool
-InterpreterManagerSymbol::createRemoteInterpreter(FreeDagNode* originalMessage,
-						  ObjectSystemRewritingContext& context,
-						  int id)
+int
+InterpreterManagerSymbol::forkRemoteInterpreter(MixfixModule* m,
+						ObjectSystemRewritingContext& context,
+						RemoteProcess& process)
 {
   //
   //	Socket pair for communicating with new process.
   //
   int ioSockets[2];
   if (int errNr = makeNonblockingSocketPair(ioSockets, false))
-    {
-      errorReply(strerror(errNr), originalMessage, context);
-      return true;
-    }
+    return errNr;
   int errSockets[2];
   if (int errNr = makeNonblockingSocketPair(errSockets, true))
     {
@@ -106,8 +103,7 @@ InterpreterManagerSymbol::createRemoteInterpreter(FreeDagNode* originalMessage,
       //
       close(ioSockets[0]);
       close(ioSockets[1]);
-      errorReply(strerror(errNr), originalMessage, context);
-      return true;
+      return errNr;
     }
   //
   //	For a new Maude interpreter.
@@ -115,6 +111,7 @@ InterpreterManagerSymbol::createRemoteInterpreter(FreeDagNode* originalMessage,
   pid_t pid = fork();
   if (pid == -1)
     {
+      int errorNumber = errno;
       //
       //	Must not leak file descriptors.
       //
@@ -122,11 +119,8 @@ InterpreterManagerSymbol::createRemoteInterpreter(FreeDagNode* originalMessage,
       close(errSockets[1]);
       close(ioSockets[0]);
       close(ioSockets[1]);
-      errorReply(strerror(errno), originalMessage, context);
-      return true;
+      return errorNumber;
     }
-  Symbol* s = originalMessage->symbol();
-  MixfixModule* m = safeCast(MixfixModule*, s->getModule());
   if (pid == 0)
     {
       //
@@ -138,6 +132,21 @@ InterpreterManagerSymbol::createRemoteInterpreter(FreeDagNode* originalMessage,
       //globalAdvisoryFlag = false;  // limit crap that we dump on screen
       close(ioSockets[0]);
       close(errSockets[0]);  // close parent end
+      //
+      //	Close our copies of the parent ends of our siblings' sockets
+      //	so they see EOF when the parent goes away, even if they
+      //	outlive the command that created them.
+      //
+      for (const auto& p : remoteInterpreters)
+	{
+	  close(p.second.ioSocket);
+	  close(p.second.errSocket);
+	}
+      for (const RemoteProcess& p : idleProcesses)
+	{
+	  close(p.ioSocket);
+	  close(p.errSocket);
+	}
       dup2(errSockets[1], STDERR_FILENO);  // replace stderr with errSockets[1]
       //
       //	We disable slow-route stuff; in particular
@@ -147,17 +156,111 @@ InterpreterManagerSymbol::createRemoteInterpreter(FreeDagNode* originalMessage,
       becomeRemoteInterpreter(ioSockets[1], m, context);  // doesn't return
     }
   //
-  //	We're the parent; record details of process and sockets.
+  //	We're the parent.
   //
-  RemoteInterpreter& ri = remoteInterpreters[id];
   close(ioSockets[1]);
   close(errSockets[1]);  // close child end
-  ri.processId = pid;
-  ri.ioSocket = ioSockets[0];
-  ri.errSocket = errSockets[0];
-  ri.charArray = 0;
-  ri.unsent = 0;
-  ri.nrUnsent = 0;
+  process.processId = pid;
+  process.ioSocket = ioSockets[0];
+  process.errSocket = errSockets[0];
+  return 0;
+}
+
+bool
+InterpreterManagerSymbol::takeFromPool(RemoteProcess& process)
+{
+  while (!idleProcesses.empty())
+    {
+      int last = idleProcesses.size() - 1;
+      process = idleProcesses[last];
+      idleProcesses.contractTo(last);
+      //
+      //	An idle process could have been killed behind our back.
+      //
+      if (waitpid(process.processId, 0, WNOHANG) == 0)
+	return true;
+      close(process.ioSocket);
+      close(process.errSocket);
+    }
+  return false;
+}
+
+void
+InterpreterManagerSymbol::fillPool(MixfixModule* m, ObjectSystemRewritingContext& context)
+{
+  while (idleProcesses.size() < static_cast<size_t>(poolSize))
+    {
+      RemoteProcess process;
+      if (forkRemoteInterpreter(m, context, process) != 0)
+	break;  // not our problem until a pooled process is needed
+      idleProcesses.append(process);
+    }
+}
+
+bool
+InterpreterManagerSymbol::recycle(RemoteInterpreter& ri)
+{
+  //
+  //	We can only reuse a process that is not in the middle of a
+  //	conversation, otherwise its next user could see stale replies.
+  //
+  if (idleProcesses.size() >= static_cast<size_t>(poolSize) ||
+      ri.nrPendingReplies != 0 || !ri.outgoingFrames.empty() || ri.nrBytesReceived != 0)
+    return false;
+  clearFlags(ri.ioSocket);
+  clearFlags(ri.errSocket);
+  cancelChildExitCallback(ri.processId);
+  RemoteProcess process;
+  process.processId = ri.processId;
+  process.ioSocket = ri.ioSocket;
+  process.errSocket = ri.errSocket;
+  idleProcesses.append(process);
+  return true;
+}
+
+void
+InterpreterManagerSymbol::drainPool()
+{
+  for (const RemoteProcess& p : idleProcesses)
+    {
+      close(p.ioSocket);
+      close(p.errSocket);
+      kill(p.processId, SIGTERM);
+      waitpid(p.processId, 0, 0);
+    }
+  idleProcesses.clear();
+}
+
+bool
+InterpreterManagerSymbol::createRemoteInterpreter(FreeDagNode* originalMessage,
+						  ObjectSystemRewritingContext& context,
+						  int id)
+{
+  Symbol* s = originalMessage->symbol();
+  MixfixModule* m = safeCast(MixfixModule*, s->getModule());
+  RemoteProcess process;
+  if (!takeFromPool(process))
+    {
+      if (int errNr = forkRemoteInterpreter(m, context, process))
+	{
+	  errorReply(strerror(errNr), originalMessage, context);
+	  return true;
+	}
+      //
+      //	Our pool was empty, so we pay for forking spare processes
+      //	now rather than on each of the following creations.
+      //
+      fillPool(m, context);
+    }
+  //
+  //	Record details of process and sockets.
+  //
+  RemoteInterpreter& ri = remoteInterpreters[id];
+  ri.processId = process.processId;
+  ri.ioSocket = process.ioSocket;
+  ri.errSocket = process.errSocket;
+  ri.nrBytesSent = 0;
+  ri.nrBytesReceived = 0;
   ri.nrPendingReplies = 0;
   ri.savedContext = &context;
   ri.module = m;
@@ -189,17 +292,13 @@ InterpreterManagerSymbol::remoteHandleMessage(FreeDagNode* message,
 					      ObjectSystemRewritingContext& context,
 					      RemoteInterpreter* r)
 {
-  if (r->unsent != 0)
-    {
-      //
-      //	We already have a send of a message in process so we
-      //	can't start sending another one - leave it in the configuration.
-      //
-      return false;
-    }
+  //
+  //	If a send of an earlier message is still in progress, this one
+  //	just queues up behind it; the child handles requests in order so
+  //	replies come back in the order requests were sent.
+  //
   DebugAdvisory("sending request " << message);
-  Rope text = r->module->serialize(message);
-  nonblockingSendMessage(*r, text);
+  nonblockingSendMessage(*r, message);
   //
   //	We don't want to wait for a reply; instead we just increment
   //	the count of replies we are owed, and if this is the first one,
@@ -221,9 +320,11 @@ InterpreterManagerSymbol::remoteHandleMessage(FreeDagNode* message,
 }
 
 void
-InterpreterManagerSymbol::remoteHandleReply(RemoteInterpreter* r, const Rope& reply)
+InterpreterManagerSymbol::remoteHandleReply(RemoteInterpreter* r,
+					    const char* reply,
+					    size_t length)
 {
-  DagNode* replyDag = r->module->deserialize(reply);
+  DagNode* replyDag = r->module->deserialize(reply, length);
   DagNode* target = safeCast(FreeDagNode*, replyDag)->getArgument(0);
   r->savedContext->bufferMessage(target, replyDag);
   --(r->nrPendingReplies);
@@ -296,6 +397,5 @@ InterpreterManagerSymbol::doChildExit(pid_t childPid)
   //
   //	Delete interpreter.
   //
-  delete i->second.charArray;
   remoteInterpreters.erase(i);
 }
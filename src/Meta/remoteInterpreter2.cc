@@ -23,112 +23,83 @@
 //
 //      Remote metaInterpreters: child side
 //
-#define EOT '\004'
 
-Rope
-InterpreterManagerSymbol::receiveMessage(int socketId)
+void
+InterpreterManagerSymbol::appendFrame(string& buffer, MixfixModule* m, DagNode* message)
+{
+  //
+  //	The message is serialized straight into the buffer after room
+  //	for its length, which we fill in afterwards.
+  //
+  size_t start = buffer.size();
+  buffer.resize(start + sizeof(FrameLength));
+  m->serialize(message, buffer);
+  FrameLength length = buffer.size() - (start + sizeof(FrameLength));
+  memcpy(&buffer[start], &length, sizeof(FrameLength));
+}
+
+void
+InterpreterManagerSymbol::receiveBytes(int socketId, char* destination, size_t nrBytes)
 {
   static char buffer[READ_BUFFER_SIZE];
   static ssize_t nextValidIndex = 0;
   static ssize_t n = 0;
 
-  Rope message;
-  //
-  //	Left over characters from last read?
-  //
-  if (nextValidIndex != 0)
-    {
-      //
-      //	May be many messages terminated by EOTs.
-      //
-      for (int i = nextValidIndex; i < n; ++i)
-	{
-	  if (buffer[i] == EOT)
-	    {
-	      //
-	      //	Saw end of a message.
-	      //
-	      message = Rope(buffer + nextValidIndex, i - nextValidIndex);
-	      if (i + 1 < n)
-		{
-		  //
-		  //	More characters beyond message so save them.
-		  //
-		  nextValidIndex = i + 1;
-		}
-	      else
-		{
-		  //
-		  //	No more characters.
-		  //
-		  nextValidIndex = 0;
-		}
-	      return message;
-	    }
-	} 
-      message = Rope(buffer + nextValidIndex, n - nextValidIndex);
-    }
-
-  for (;;)
+  while (nrBytes > 0)
     {
-      //
-      //	Get whatever characters are available, restarting
-      //	interrupted calls.
-      //
-      do
-	n = read(socketId, buffer, READ_BUFFER_SIZE);
-      while (n == -1 && errno == EINTR);
-      Assert(n != -1, "unexpected read failure: " << strerror(errno));
-      if (n == 0)
+      if (nextValidIndex == n)
 	{
 	  //
-	  //	EOF means parent must have closed socket so we
-	  //	need to exit.
+	  //	Buffer is empty; get whatever characters are available,
+	  //	restarting interrupted calls. Large reads go directly to
+	  //	their destination.
 	  //
-	  exit(UserLevelRewritingContext::SOCKET_CLOSED);
-	}
-      for (ssize_t i = 0; i < n; ++i)
-	{
-	  if (buffer[i] == EOT)
+	  bool direct = (nrBytes >= READ_BUFFER_SIZE);
+	  ssize_t r;
+	  do
+	    r = direct ? read(socketId, destination, nrBytes) : read(socketId, buffer, READ_BUFFER_SIZE);
+	  while (r == -1 && errno == EINTR);
+	  Assert(r != -1, "unexpected read failure: " << strerror(errno));
+	  if (r == 0)
 	    {
 	      //
-	      //	Saw end of a message.
+	      //	EOF means parent must have closed socket so we
+	      //	need to exit.
 	      //
-	      message += Rope(buffer, i);
-	      if (i + 1 < n)
-		{
-		  //
-		  //	More characters beyond message so save them.
-		  //
-		  nextValidIndex = i + 1;
-		}
-	      else
-		{
-		  //
-		  //	No more characters.
-		  //
-		  nextValidIndex = 0;
-		}
-	      return message;
+	      exit(UserLevelRewritingContext::SOCKET_CLOSED);
 	    }
+	  if (direct)
+	    {
+	      destination += r;
+	      nrBytes -= r;
+	      continue;
+	    }
+	  n = r;
+	  nextValidIndex = 0;
 	}
-      //
-      //	Add all characters.
-      //
-      message += Rope(buffer, n);
+      size_t available = n - nextValidIndex;
+      size_t nrToCopy = (available < nrBytes) ? available : nrBytes;
+      memcpy(destination, buffer + nextValidIndex, nrToCopy);
+      nextValidIndex += nrToCopy;
+      destination += nrToCopy;
+      nrBytes -= nrToCopy;
     }
-  return message;  // dummy
 }
 
 void
-InterpreterManagerSymbol::sendMessage(int socketId, const Rope& message)
+InterpreterManagerSymbol::receiveMessage(int socketId, string& message)
+{
+  FrameLength length;
+  receiveBytes(socketId, reinterpret_cast<char*>(&length), sizeof(FrameLength));
+  message.resize(length);
+  receiveBytes(socketId, &message[0], length);
+}
+
+void
+InterpreterManagerSymbol::sendMessage(int socketId, const string& frames)
 {
-  Rope::size_type length = message.length();
-  char* charArray = message.makeZeroTerminatedString();
-  charArray[length] = EOT;  // change NUL to EOT
-  
-  ssize_t nrUnsent = length + 1;
-  char* p = charArray;
+  ssize_t nrUnsent = frames.size();
+  const char* p = frames.data();
   do
     {
       ssize_t n;
@@ -139,7 +110,6 @@ InterpreterManagerSymbol::sendMessage(int socketId, const Rope& message)
       nrUnsent -= n;
     }
   while (nrUnsent > 0);
-  delete [] charArray;
 }
 
 void
@@ -148,23 +118,25 @@ InterpreterManagerSymbol::becomeRemoteInterpreter(int socketId,
 						  ObjectSystemRewritingContext& context)
 {
   Interpreter* interpreter = new Interpreter;
+  string request;
+  string reply;
 
   for (;;)
     {
-      Rope request = receiveMessage(socketId);
+      receiveMessage(socketId, request);
       //
       //	Deserialized dag is vulnerable to the garbage collector so
       //	protect it.
       //
-      DagRoot requestDag(m->deserialize(request));
+      DagRoot requestDag(m->deserialize(request.data(), request.size()));
       //
       //	We only support message symbols in the free theory.
       //
       DagNode* replyDag = handleMessage(safeCast(FreeDagNode*, requestDag.getNode()),
 					context,
 					interpreter);
-      Rope reply = m->serialize(replyDag);
-      //cerr << "reply = " << reply << endl;
+      reply.clear();
+      appendFrame(reply, m, replyDag);
       sendMessage(socketId, reply);
     }
 }
@@ -194,6 +166,10 @@ InterpreterManagerSymbol::handleMessage(FreeDagNode* message,
     return reduceTerm(message, context, interpreter);
   else if (s == rewriteTermMsg)
     return rewriteTerm(message, context, interpreter);
+  else if (s == reduceTermsMsg)
+    return reduceTerms(message, context, interpreter);
+  else if (s == rewriteTermsMsg)
+    return rewriteTerms(message, context, interpreter);
   else if (s == frewriteTermMsg)
     return frewriteTerm(message, context, interpreter);
   else if (s == erewriteTermMsg)
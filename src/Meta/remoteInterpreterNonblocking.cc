@@ -21,56 +21,48 @@
 */
 
 void
-InterpreterManagerSymbol::nonblockingSendMessage(RemoteInterpreter& ri, const Rope& message)
+InterpreterManagerSymbol::nonblockingSendMessage(RemoteInterpreter& ri, DagNode* message)
 {
-  Assert(ri.nrUnsent == 0, "can't send another message while previous one is being sent");
   //
-  //	Send as much as we can, and send the rest using call-backs.
+  //	Frames queue up behind any that haven't been completely sent yet,
+  //	so that requests can be pipelined without waiting for replies.
   //
-  int socketId = ri.ioSocket;
-  Rope::size_type length = message.length();
-  char* charArray = message.makeZeroTerminatedString();
-  charArray[length] = EOT;  // change NUL to EOT
+  bool wasIdle = ri.outgoingFrames.empty();
+  appendFrame(ri.outgoingFrames, ri.module, message);
+  if (wasIdle)
+    {
+      //
+      //	Send as much as we can, and send the rest using call-backs.
+      //
+      if (!writeOutgoingFrames(ri, true))
+	wantTo(WRITE, ri.ioSocket);
+    }
+}
 
-  ssize_t nrUnsent = length + 1;
-  char* p = charArray;
+bool
+InterpreterManagerSymbol::writeOutgoingFrames(RemoteInterpreter& ri, bool mightBlock)
+{
+  //
+  //	Returns true if everything queued has been sent.
+  //
+  int fd = ri.ioSocket;
   //
   //	Restart interrupted calls.
   //
   ssize_t n;
   do
-    n = write(socketId, p, nrUnsent);
+    n = write(fd, ri.outgoingFrames.data() + ri.nrBytesSent, ri.outgoingFrames.size() - ri.nrBytesSent);
   while (n == -1 && errno == EINTR);
   //
-  //	We treat a blocking situation as zero characters sent.
+  //	We treat a blocking situation as zero characters sent; in a
+  //	callback we expect to be able to write at least one character.
   //
   if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
-    n = 0;
-  if (n >= 0)
     {
-      nrUnsent -= n;
-      if (nrUnsent == 0)
-	{
-	  //
-	  //	All characters sent.
-	  //
-	  delete [] charArray;
-	  return;
-	}
-      else
-	{
-	  //
-	  //	Need to send more characters when socket becomes
-	  //	available for writing.
-	  //
-	  ri.nrUnsent = nrUnsent;
-	  ri.charArray = charArray;
-	  ri.unsent = charArray + n;
-	  wantTo(WRITE, socketId);
-	  return;
-	}
+      Assert(mightBlock, "unexpected would block in doWrite() callback");
+      n = 0;
     }
-  else
+  if (n < 0)
     {
       //
       //	We had an error that wasn't due to an interrupt or
@@ -79,6 +71,26 @@ InterpreterManagerSymbol::nonblockingSendMessage(RemoteInterpreter& ri, const Ro
       //
       CantHappen("write() failed");
     }
+  ri.nrBytesSent += n;
+  if (ri.nrBytesSent == ri.outgoingFrames.size())
+    {
+      //
+      //	All characters sent.
+      //
+      ri.outgoingFrames.clear();
+      ri.nrBytesSent = 0;
+      return true;
+    }
+  if (2 * ri.nrBytesSent > ri.outgoingFrames.size())
+    {
+      //
+      //	Don't let sent characters pile up in front of a queue that
+      //	never quite drains.
+      //
+      ri.outgoingFrames.erase(0, ri.nrBytesSent);
+      ri.nrBytesSent = 0;
+    }
+  return false;
 }
 
 void
@@ -95,48 +107,13 @@ InterpreterManagerSymbol::doWrite(int fd)
 	ri = &p.second;
     }
   Assert(ri != 0, "couldn't find remote interpreter for doWrite() callback");
-  //
-  //	Restart interrupted calls.
-  //	Because we're in a callback we expect to be able to write at
-  //	at least one character without blocking.
-  //
-  ssize_t n;
-  do
-    n = write(fd, ri->unsent, ri->nrUnsent);
-  while (n == -1 && errno == EINTR);
-  Assert(n != 0, "unexpected zero characters written");
-  Assert(!(n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)),
-	 "unexpected would block in doWrite() callback");
-  
-  if (n >= 0)  // include 0 case here for safety, though it should not arise
-    {
-      ri->nrUnsent -= n;
-      if (ri->nrUnsent == 0)
-	{
-	  //
-	  //	Finished sending; tidy up.
-	  //
-	  delete [] ri->charArray;
-	  ri->charArray = 0;
-	  ri->unsent = 0;
-	}
-      else
-	{
-	  //
-	  //	Need to move unsent pointers and request another callback.
-	  //
-	  ri->unsent += n;
-	  wantTo(WRITE, fd);
-	}
-    }
-  else
+  if (!writeOutgoingFrames(*ri, false))
     {
       //
-      //	We had an error that wasn't due to an interrupt or
-      //	not wanting to block. We must assume connection is broken.
-      //	Not sure for the moment how to clean up.
+      //	Need to send more characters when socket becomes
+      //	available for writing.
       //
-      CantHappen("write() failed in callback");
+      wantTo(WRITE, fd);
     }
 }
 
@@ -181,44 +158,65 @@ InterpreterManagerSymbol::doRead(int fd)
   //	callbacks (one per fair traversal) to get it all.
   //
   bool sawEOF = false;
+  string& frames = ri->incomingFrames;
   for (;;)
     {
-      char buffer[READ_BUFFER_SIZE];
+      //
+      //	Make sure there is room to read into. If we know the length
+      //	of the frame at the front, we make room for all of it so that
+      //	it ends up in one place without further copying.
+      //
+      size_t wanted = ri->nrBytesReceived + READ_BUFFER_SIZE;
+      if (ri->nrBytesReceived >= sizeof(FrameLength))
+	{
+	  FrameLength length;
+	  memcpy(&length, frames.data(), sizeof(FrameLength));
+	  if (sizeof(FrameLength) + length > wanted)
+	    wanted = sizeof(FrameLength) + length;
+	}
+      if (frames.size() < wanted)
+	frames.resize(wanted);
       ssize_t n;
       //
       //	Get as many characters as are available.
       //	Restart interrupted calls to read().
       //
       do
-	n = read(fd, buffer, READ_BUFFER_SIZE);
+	n = read(fd, &frames[ri->nrBytesReceived], frames.size() - ri->nrBytesReceived);
       while (n == -1 && errno == EINTR);
       if (n > 0)
 	{
 	  //
-	  //	We got characters; look for an EOT that signals the end
-	  //	of a DAG, then we can dispatch the message it encodes.
+	  //	We got characters; dispatch the message encoded by each
+	  //	complete frame and keep any partial frame for later.
 	  //
-	  ssize_t messageStart = 0;
-	  for (ssize_t i = 0; i < n; ++i)
+	  ri->nrBytesReceived += n;
+	  size_t consumed = 0;
+	  for (;;)
 	    {
-	      if (buffer[i] == EOT)
-		{
-		  ri->incomingMessage += Rope(buffer + messageStart, i - messageStart);
-		  remoteHandleReply(ri, ri->incomingMessage);
-		  ri->incomingMessage.clear();
-		  messageStart = i + 1;
-		}
+	      size_t available = ri->nrBytesReceived - consumed;
+	      if (available < sizeof(FrameLength))
+		break;
+	      FrameLength length;
+	      memcpy(&length, frames.data() + consumed, sizeof(FrameLength));
+	      if (available - sizeof(FrameLength) < length)
+		break;
+	      remoteHandleReply(ri, frames.data() + consumed + sizeof(FrameLength), length);
+	      consumed += sizeof(FrameLength) + length;
 	    }
-	  ssize_t nrCharsLeft = n - messageStart;
-	  if (nrCharsLeft > 0)
+	  if (consumed > 0)
 	    {
-	      //
-	      //	Either we didn't see an EOT or there are characters beyond
-	      //	the last EOT; the remaining characters the start of another DAG.
-	      //	
-	      ri->incomingMessage += Rope(buffer + messageStart, nrCharsLeft);
-	      Assert(ri->nrPendingReplies > 0, "partial message yet no pending replies");
+	      ri->nrBytesReceived -= consumed;
+	      memmove(&frames[0], frames.data() + consumed, ri->nrBytesReceived);
+	      if (ri->nrBytesReceived == 0 && frames.size() > MAX_IDLE_READ_BUFFER)
+		{
+		  //
+		  //	Don't hang on to the space for a huge reply.
+		  //
+		  string().swap(frames);
+		}
 	    }
+	  Assert(ri->nrBytesReceived == 0 || ri->nrPendingReplies > 0, "partial message yet no pending replies");
 	}
       else
 	{
@@ -282,17 +280,17 @@ InterpreterManagerSymbol::outputWholeErrorLines(RemoteInterpreter* ri)
 	    {
 	      if (buffer[i] == '\n')
 		{
-		  ri->incomingMessage += Rope(buffer + messageStart, i - messageStart);
+		  ri->incomingErrorLine += Rope(buffer + messageStart, i - messageStart);
 		  //cerr << "----> ";
-		  cerr << ri->incomingMessage << endl;
-		  ri->incomingMessage.clear();
+		  cerr << ri->incomingErrorLine << endl;
+		  ri->incomingErrorLine.clear();
 		  messageStart = i + 1;
 		}
 	    }
 	  ssize_t nrCharsLeft = n - messageStart;
 	  if (nrCharsLeft > 0)
 	    {
-	      ri->incomingMessage += Rope(buffer + messageStart, nrCharsLeft);
+	      ri->incomingErrorLine += Rope(buffer + messageStart, nrCharsLeft);
 	      Assert(ri->nrPendingReplies > 0, "partial message yet no pending replies");
 	    }
 	}
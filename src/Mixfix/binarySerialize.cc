@@ -0,0 +1,407 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	Routines for serializing a dag in a compact binary format.
+//
+//	An encoding starts with a header consisting of BINARY_MAGIC, "MD" and
+//	a version byte. It is followed by a record for each dag node, in
+//	post-order so that the last record is the root. Unsigned integers are
+//	written as varints (7 bits per byte, least significant first). Each
+//	record starts with (index << RECORD_KIND_BITS) | kind, where index is
+//	a symbol index, a polymorph index or a sort index depending on kind.
+//	Polymorph records then have the kind index of the instantiation.
+//	Sort test records have a single argument. Variable records have the
+//	length and bytes of the variable name. Other records have a payload
+//	that depends on the symbol type, followed by the number of arguments,
+//	and each argument as the distance back to the record that encodes it.
+//
+//	Payloads are raw bytes: a magnitude for an iterated symbol, 8 bytes
+//	for a float, a length and bytes for a string or quoted identifier, and
+//	a signed numerator and a denominator for an SMT number. Magnitudes are
+//	a length, with the sign in bit 0 where needed, followed by big-endian
+//	bytes.
+//
+
+bool MixfixModule::textSerialization = false;
+
+Rope
+MixfixModule::serialize(DagNode* dagNode)
+{
+  if (textSerialization)
+    return textSerialize(dagNode);
+  string accumulator;
+  binarySerialize(dagNode, accumulator);
+  return Rope(accumulator.data(), accumulator.size());
+}
+
+void
+MixfixModule::serialize(DagNode* dagNode, string& buffer)
+{
+  if (textSerialization)
+    {
+      Rope text = textSerialize(dagNode);
+      size_t start = buffer.size();
+      buffer.resize(start + text.length());
+      text.copy(&buffer[start]);
+    }
+  else
+    binarySerialize(dagNode, buffer);
+}
+
+DagNode*
+MixfixModule::deserialize(const Rope& encoding)
+{
+  extern DagNode* deserializeRope(MixfixModule*, const Rope&);
+
+  if (!encoding.empty() && static_cast<unsigned char>(encoding[0]) == BINARY_MAGIC)
+    {
+      //
+      //	Binary decoding works on a contiguous buffer.
+      //
+      Rope::size_type length = encoding.length();
+      string buffer(length, '\0');
+      encoding.copy(&buffer[0]);
+      return binaryDeserialize(buffer.data(), length);
+    }
+  return deserializeRope(this, encoding);
+}
+
+DagNode*
+MixfixModule::deserialize(const char* data, size_t length)
+{
+  if (length > 0 && static_cast<unsigned char>(data[0]) == BINARY_MAGIC)
+    return binaryDeserialize(data, length);
+  return deserialize(Rope(data, length));
+}
+
+void
+MixfixModule::appendVarint(string& accumulator, Uint64 value)
+{
+  while (value >= 0x80)
+    {
+      accumulator += static_cast<char>((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+  accumulator += static_cast<char>(value);
+}
+
+Uint64
+MixfixModule::readVarint(const unsigned char*& position)
+{
+  Uint64 value = 0;
+  for (int shift = 0;; shift += 7)
+    {
+      unsigned char byte = *position++;
+      value |= static_cast<Uint64>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+	break;
+    }
+  return value;
+}
+
+void
+MixfixModule::appendMagnitude(string& accumulator, const mpz_class& number, int signBit)
+{
+  mpz_srcptr z = number.get_mpz_t();
+  size_t nrBytes = (mpz_sgn(z) == 0) ? 0 : (mpz_sizeinbase(z, 2) + 7) / 8;
+  if (signBit == NONE)
+    appendVarint(accumulator, nrBytes);
+  else
+    appendVarint(accumulator, (nrBytes << 1) | signBit);
+  size_t oldSize = accumulator.size();
+  accumulator.resize(oldSize + nrBytes);
+  if (nrBytes > 0)
+    mpz_export(&accumulator[oldSize], 0, 1, 1, 0, 0, z);
+}
+
+void
+MixfixModule::readMagnitude(const unsigned char*& position, mpz_class& number, bool hasSignBit)
+{
+  Uint64 code = readVarint(position);
+  size_t nrBytes = hasSignBit ? (code >> 1) : code;
+  mpz_import(number.get_mpz_t(), nrBytes, 1, 1, 0, 0, position);
+  position += nrBytes;
+  if (hasSignBit && (code & 1))
+    number = -number;
+}
+
+void
+MixfixModule::binarySerialize(DagNode* dagNode, string& accumulator)
+{
+  accumulator += static_cast<char>(BINARY_MAGIC);
+  accumulator += 'M';
+  accumulator += 'D';
+  accumulator += static_cast<char>(BINARY_VERSION);
+  //
+  //	Post-order traversal using an explicit stack since dags moved
+  //	between processes can be too deep for recursion. A node may be
+  //	stacked more than once if it is shared, but only the first copy
+  //	to reach the top generates a record.
+  //
+  PointerSet visited;
+  Vector<PendingDagNode> stack;
+  Vector<DagNode*> args;
+  PendingDagNode p = { dagNode, false };
+  stack.append(p);
+  while (!stack.empty())
+    {
+      int top = stack.size() - 1;
+      DagNode* d = stack[top].dagNode;
+      if (visited.pointer2Index(d) != NONE)
+	stack.contractTo(top);
+      else if (stack[top].expanded)
+	{
+	  stack.contractTo(top);
+	  appendRecord(d, visited, args, accumulator);
+	}
+      else
+	{
+	  stack[top].expanded = true;
+	  args.clear();
+	  for (DagArgumentIterator a(*d); a.valid(); a.next())
+	    args.append(a.argument());
+	  //
+	  //	Stack arguments in reverse order so that the first
+	  //	argument gets the smallest index.
+	  //
+	  for (int i = args.size() - 1; i >= 0; --i)
+	    {
+	      if (visited.pointer2Index(args[i]) == NONE)
+		{
+		  p.dagNode = args[i];
+		  stack.append(p);
+		}
+	    }
+	}
+    }
+}
+
+void
+MixfixModule::appendRecord(DagNode* dagNode,
+			   PointerSet& visited,
+			   Vector<DagNode*>& args,
+			   string& accumulator)
+{
+  Symbol* symbol = dagNode->symbol();
+  int indexWithinModule = symbol->getIndexWithinModule();
+  SymbolType type = symbolInfo[indexWithinModule].symbolType;
+  //
+  //	Sort test symbols, variable symbols and polymorph instances may not
+  //	exist in the other process, so we encode them in terms of things
+  //	that do, just as in the text format.
+  //
+  if (type.getBasicType() == SymbolType::VARIABLE)
+    {
+      VariableSymbol* vs = safeCast(VariableSymbol*, symbol);
+      appendVarint(accumulator, (vs->getSort()->getIndexWithinModule() << RECORD_KIND_BITS) |
+		   VARIABLE_RECORD);
+      const char* name = Token::name(safeCast(VariableDagNode*, dagNode)->id());
+      size_t length = strlen(name);
+      appendVarint(accumulator, length);
+      accumulator.append(name, length);
+      (void) visited.insert(dagNode);
+      return;
+    }
+  int thisIndex = visited.cardinality();
+  if (type.getBasicType() == SymbolType::SORT_TEST)
+    {
+      SortTestSymbol* st = safeCast(SortTestSymbol*, symbol);
+      appendVarint(accumulator, (st->sort()->getIndexWithinModule() << RECORD_KIND_BITS) |
+		   (st->eager() ? EAGER_SORT_TEST_RECORD : LAZY_SORT_TEST_RECORD));
+      DagArgumentIterator a(*dagNode);
+      appendVarint(accumulator, thisIndex - visited.pointer2Index(a.argument()));
+      (void) visited.insert(dagNode);
+      return;
+    }
+
+  short polymorphIndex = symbolInfo[indexWithinModule].polymorphIndex;
+  if (polymorphIndex != NONE)
+    {
+      Polymorph& p = polymorphs[polymorphIndex];
+      int kindIndex = 0;
+      while (p.instantiations[kindIndex] != symbol)
+	++kindIndex;
+      appendVarint(accumulator, (polymorphIndex << RECORD_KIND_BITS) | POLYMORPH_RECORD);
+      appendVarint(accumulator, kindIndex);
+    }
+  else
+    appendVarint(accumulator, (indexWithinModule << RECORD_KIND_BITS) | REGULAR_RECORD);
+
+  if (type.hasFlag(SymbolType::ITER))
+    appendMagnitude(accumulator, safeCast(S_DagNode*, dagNode)->getNumber(), NONE);
+
+  switch (type.getBasicType())
+    {
+    case SymbolType::FLOAT:
+      {
+	//
+	//	We keep the exact bit pattern.
+	//
+	double d = safeCast(FloatDagNode*, dagNode)->getValue();
+	char bytes[sizeof(double)];
+	memcpy(bytes, &d, sizeof(double));
+	accumulator.append(bytes, sizeof(double));
+	break;
+      }
+    case SymbolType::STRING:
+      {
+	const Rope& value = safeCast(StringDagNode*, dagNode)->getValue();
+	Rope::size_type length = value.length();
+	appendVarint(accumulator, length);
+	size_t oldSize = accumulator.size();
+	accumulator.resize(oldSize + length);
+	value.copy(&accumulator[oldSize]);
+	break;
+      }
+    case SymbolType::QUOTED_IDENTIFIER:
+      {
+	const char* name = Token::name(safeCast(QuotedIdentifierDagNode*, dagNode)->getIdIndex());
+	size_t length = strlen(name);
+	appendVarint(accumulator, length);
+	accumulator.append(name, length);
+	break;
+      }
+    case SymbolType::SMT_NUMBER_SYMBOL:
+      {
+	const mpq_class& rat = safeCast(SMT_NumberDagNode*, dagNode)->getValue();
+	appendMagnitude(accumulator, rat.get_num(), rat.get_num() < 0);
+	appendMagnitude(accumulator, rat.get_den(), NONE);
+	break;
+      }
+    }
+
+  args.clear();
+  for (DagArgumentIterator a(*dagNode); a.valid(); a.next())
+    args.append(a.argument());
+  int nrArgs = args.size();
+  appendVarint(accumulator, nrArgs);
+  for (int i = 0; i < nrArgs; ++i)
+    appendVarint(accumulator, thisIndex - visited.pointer2Index(args[i]));
+  (void) visited.insert(dagNode);
+}
+
+DagNode*
+MixfixModule::binaryDeserialize(const char* data, size_t length)
+{
+  const unsigned char* position = reinterpret_cast<const unsigned char*>(data);
+  const unsigned char* end = position + length;
+  Assert(length >= BINARY_HEADER_SIZE && position[0] == BINARY_MAGIC &&
+	 position[1] == 'M' && position[2] == 'D', "bad header");
+  if (position[3] != BINARY_VERSION)
+    CantHappen("unsupported binary serialization version " << static_cast<int>(position[3]));
+  position += BINARY_HEADER_SIZE;
+
+  const Vector<Sort*>& sorts = getSorts();
+  const Vector<Symbol*>& symbols = getSymbols();
+  Vector<DagNode*> history;
+  Vector<DagNode*> args;
+  string name;
+  mpz_class number;
+  while (position < end)
+    {
+      Uint64 code = readVarint(position);
+      int index = code >> RECORD_KIND_BITS;
+      int kind = code & ((1 << RECORD_KIND_BITS) - 1);
+      int thisIndex = history.size();
+      DagNode* d = 0;
+      switch (kind)
+	{
+	case VARIABLE_RECORD:
+	  {
+	    size_t nameLength = readVarint(position);
+	    name.assign(reinterpret_cast<const char*>(position), nameLength);
+	    position += nameLength;
+	    Symbol* symbol = instantiateVariable(sorts[index]);
+	    d = new VariableDagNode(safeCast(VariableSymbol*, symbol), Token::encode(name.c_str()), NONE);
+	    break;
+	  }
+	case EAGER_SORT_TEST_RECORD:
+	case LAZY_SORT_TEST_RECORD:
+	  {
+	    Symbol* symbol = instantiateSortTest(sorts[index], kind == EAGER_SORT_TEST_RECORD);
+	    args.resize(1);
+	    args[0] = history[thisIndex - readVarint(position)];
+	    d = symbol->makeDagNode(args);
+	    break;
+	  }
+	default:
+	  {
+	    Symbol* symbol = (kind == POLYMORPH_RECORD) ?
+	      instantiatePolymorph(index, readVarint(position)) : symbols[index];
+	    SymbolType type = getSymbolType(symbol);
+	    if (type.hasFlag(SymbolType::ITER))
+	      readMagnitude(position, number, false);
+	    switch (type.getBasicType())
+	      {
+	      case SymbolType::FLOAT:
+		{
+		  double value;
+		  memcpy(&value, position, sizeof(double));
+		  position += sizeof(double);
+		  d = new FloatDagNode(safeCast(FloatSymbol*, symbol), value);
+		  break;
+		}
+	      case SymbolType::STRING:
+		{
+		  size_t stringLength = readVarint(position);
+		  Rope value(reinterpret_cast<const char*>(position), stringLength);
+		  position += stringLength;
+		  d = new StringDagNode(safeCast(StringSymbol*, symbol), value);
+		  break;
+		}
+	      case SymbolType::QUOTED_IDENTIFIER:
+		{
+		  size_t nameLength = readVarint(position);
+		  name.assign(reinterpret_cast<const char*>(position), nameLength);
+		  position += nameLength;
+		  d = new QuotedIdentifierDagNode(safeCast(QuotedIdentifierSymbol*, symbol),
+						  Token::encode(name.c_str()));
+		  break;
+		}
+	      case SymbolType::SMT_NUMBER_SYMBOL:
+		{
+		  mpq_class value;
+		  readMagnitude(position, value.get_num(), true);
+		  readMagnitude(position, value.get_den(), false);
+		  d = new SMT_NumberDagNode(safeCast(SMT_NumberSymbol*, symbol), value);
+		  break;
+		}
+	      }
+	    int nrArgs = readVarint(position);
+	    args.resize(nrArgs);
+	    for (int i = 0; i < nrArgs; ++i)
+	      args[i] = history[thisIndex - readVarint(position)];
+	    if (d == 0)
+	      {
+		d = type.hasFlag(SymbolType::ITER) ?
+		  new S_DagNode(safeCast(S_Symbol*, symbol), number, args[0]) :
+		  symbol->makeDagNode(args);
+	      }
+	    break;
+	  }
+	}
+      history.append(d);
+    }
+  Assert(position == end, "overran encoding");
+  return history[history.size() - 1];
+}
@@ -48,6 +48,7 @@ UserLevelRewritingContext::clearDebug()
   setTraceStatus(interpreter.getFlag(Interpreter::EXCEPTION_FLAGS));
   stepFlag = false;
   abortFlag = false;
+  (void) MemoryCell::heapLimitExceeded();  // in case we finished without noticing
 }
 
 /*
@@ -486,14 +487,21 @@ UserLevelRewritingContext::handleDebug(DagNode* subject, const PreEquation* pe)
   //
   //	Handle unusual situations that are common to all rewrite types:
   //	(a) Abort
-  //	(b) Info interrupt
-  //	(c) Breakpoints
-  //	(d) ^C interrupt
-  //	(e) Single stepping
+  //	(b) Heap limit exceeded
+  //	(c) Info interrupt
+  //	(d) Breakpoints
+  //	(e) ^C interrupt
+  //	(f) Single stepping
   //	In the latter 3 cases we drop into the debugger.
   //
   if (abortFlag)
     return true;
+  if (MemoryCell::heapLimitExceeded())
+    {
+      IssueWarning("live data exceeds maximum heap size; aborting execution and returning to command line.");
+      abortFlag = true;
+      return true;
+    }
   if (infoFlag)
     {
       printStatusReport(subject, pe);
@@ -96,6 +96,7 @@ Interpreter::Interpreter()
 
   flags = DEFAULT_FLAGS;
   printFlags = DEFAULT_PRINT_FLAGS;
+  nrSearchProcesses = 1;
   currentModule = 0;
   currentView = 0;
 
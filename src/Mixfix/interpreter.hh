@@ -168,6 +168,7 @@ public:
   void setPrintFlag(PrintFlags flag, bool polarity);
   bool getPrintFlag(PrintFlags flag) const;
   int getPrintFlags() const;
+  void setNrSearchProcesses(int nrProcesses);
 
   SyntacticPreModule* getCurrentModule() const;
   bool setCurrentModule(const Vector<Token>& moduleExpr, int start = 0);
@@ -355,6 +356,7 @@ private:
 
   int flags;
   int printFlags;
+  int nrSearchProcesses;	// worker processes for expanding search graphs
   SyntacticPreModule* currentModule;
   SyntacticView* currentView;
   //
@@ -373,6 +375,12 @@ private:
   set<int> concealedSymbols;	// names of symbols to have their arguments concealed during printing
 };
 
+inline void
+Interpreter::setNrSearchProcesses(int nrProcesses)
+{
+  nrSearchProcesses = nrProcesses;
+}
+
 inline void
 Interpreter::traceSelect(bool add)
 {
@@ -213,6 +213,7 @@ MixfixModule::nonTerminal(const Sort* sort, NonTerminalType type)
 #include "graphPrint.cc"
 #include "strategyPrint.cc"
 #include "serialize.cc"
+#include "binarySerialize.cc"
 
 void
 MixfixModule::checkFreshVariableNames()
@@ -39,8 +39,13 @@
 #include "symbolType.hh"
 #include "SMT_Info.hh"
 #include "SMT_NumberSymbol.hh"
+#include "dagSerializer.hh"
 
-class MixfixModule : public ProfileModule, public MetadataStore, protected SharedTokens
+class MixfixModule :
+  public ProfileModule,
+  public MetadataStore,
+  public DagSerializer,
+  protected SharedTokens
 {
   NO_COPYING(MixfixModule);
 
@@ -283,8 +288,17 @@ public:
   static Term* findNonlinearVariable(Term* term, VariableInfo& variableInfo);
   Symbol* findSMT_Symbol(Term* term);
 
+  //
+  //	Dags are serialized in a compact binary format unless text
+  //	serialization has been selected; either format is accepted by
+  //	deserialize(). The second version appends the encoding to a
+  //	buffer, which avoids a copy in the binary case.
+  //
   Rope serialize(DagNode* dagNode);
+  void serialize(DagNode* dagNode, string& buffer);
   DagNode* deserialize(const Rope& encoding);
+  DagNode* deserialize(const char* data, size_t length);
+  static void setTextSerialization(bool polarity);
 
 protected:
   static int findMatchingParen(const Vector<Token>& tokens, int pos);
@@ -749,7 +763,46 @@ private:
   static bool domainAndRangeMatch(const Vector<Sort*>& domainAndRange1,
 				  const Vector<Sort*>& domainAndRange2);
 
+  //
+  //	Serialization.
+  //
+  enum BinarySerialization
+  {
+    BINARY_MAGIC = 0x7f,	// can't start a text serialization
+    BINARY_VERSION = 1,
+    BINARY_HEADER_SIZE = 4,
+    RECORD_KIND_BITS = 3
+  };
+
+  enum RecordKind
+  {
+    REGULAR_RECORD,
+    POLYMORPH_RECORD,
+    EAGER_SORT_TEST_RECORD,
+    LAZY_SORT_TEST_RECORD,
+    VARIABLE_RECORD
+  };
+
+  struct PendingDagNode
+  {
+    DagNode* dagNode;
+    bool expanded;
+  };
+
+  Rope textSerialize(DagNode* dagNode);
   int visit(DagNode* dagNode, PointerSet& visited, Rope& accumulator);
+  void binarySerialize(DagNode* dagNode, string& accumulator);
+  void appendRecord(DagNode* dagNode,
+		    PointerSet& visited,
+		    Vector<DagNode*>& args,
+		    string& accumulator);
+  DagNode* binaryDeserialize(const char* data, size_t length);
+  static void appendVarint(string& accumulator, Uint64 value);
+  static Uint64 readVarint(const unsigned char*& position);
+  static void appendMagnitude(string& accumulator, const mpz_class& number, int signBit);
+  static void readMagnitude(const unsigned char*& position, mpz_class& number, bool hasSignBit);
+
+  static bool textSerialization;
 
   bool ambiguous(int iflags);
   static bool rangeOfArgumentsKnown(int iflags, bool rangeKnown, bool rangeDisambiguated);
@@ -1056,12 +1109,10 @@ MixfixModule::canHaveAsParameter(ModuleType t1, ModuleType t2)
   return isTheory(t2) && (((t1 | t2) & (SYSTEM | STRATEGY)) == (t1 & (SYSTEM | STRATEGY)));
 }
 
-inline DagNode*
-MixfixModule::deserialize(const Rope& encoding)
+inline void
+MixfixModule::setTextSerialization(bool polarity)
 {
-  extern DagNode* deserializeRope(MixfixModule*, const Rope&);
-  
-  return deserializeRope(this, encoding);
+  textSerialization = polarity;
 }
 
 #endif
@@ -37,6 +37,16 @@ Interpreter::printSearchTiming(const Timer& timer,  RewriteSequenceSearch* state
     {
       cout << "states: " << state->getNrStates() << "  ";
       printStats(timer, *(state->getContext()), getFlag(SHOW_TIMING));
+      if (StateTransitionGraph::getCompactMode())
+	{
+	  cout << "bytes per state: " <<
+	    state->getNrBytesUsed() / state->getNrStates() << endl;
+	}
+      if (state->usingStateHashing())
+	{
+	  cout << "estimated omission probability: " <<
+	    state->getOmissionProbability() << endl;
+	}
     }
 }
 
@@ -208,6 +218,9 @@ Interpreter::search(const Vector<Token>& bubble,
 				  static_cast<RewriteSequenceSearch::SearchType>(searchType),
 				  pattern,
 				  depth);
+      state->setExpansionPool(nrSearchProcesses, fm);
+      state->useStateHashing(false);
+      state->useStateStore();
       Timer timer(getFlag(SHOW_TIMING));
       doSearching(timer, fm, state, 0, limit);
     }
@@ -21,11 +21,11 @@
 */
 
 //
-//	Routines for serializing a dag to a Rope.
+//	Routines for serializing a dag to a Rope in text format.
 //
 
 Rope
-MixfixModule::serialize(DagNode* dagNode)
+MixfixModule::textSerialize(DagNode* dagNode)
 {
   Rope accumulator;
   PointerSet visited;
@@ -49,6 +49,7 @@
 #include "argumentIterator.hh"
 #include "dagArgumentIterator.hh"
 #include "rule.hh"
+#include "dagNodeSet.hh"
 
 //      ACU theory class definitions
 #include "ACU_Symbol.hh"
@@ -207,9 +208,9 @@ ConfigSymbol::resetRules()
   for (RuleMap::iterator i = ruleMap.begin(); i != e; ++i)
     {
       RuleSet& rs = (*i).second;
-      rs.next = rs.rules.begin();
+      rs.next = 0;
     }
-  leftOver.next = leftOver.rules.begin();
+  leftOver.next = 0;
 }
 
 DagNode*
@@ -224,7 +225,7 @@ ConfigSymbol::ruleRewrite(DagNode* subject, RewritingContext& context)
 
   ACU_DagNode* s = safeCastNonNull<ACU_DagNode*>(subject);
   int nrArgs = s->nrArgs();
-  ObjectMap objectMap;
+  ObjectMap objectMap(nrArgs);
   Remainder remainder;
   for (int i = 0; i < nrArgs; i++)
     {
@@ -286,20 +287,29 @@ ConfigSymbol::ruleRewrite(DagNode* subject, RewritingContext& context)
   Vector<DagNode*> dagNodes(2);
   Vector<int> multiplicities(2);
   bool delivered = false;
-  const ObjectMap::iterator e = objectMap.end();
-  for (ObjectMap::iterator i = objectMap.begin(); i != e; ++i)
+  //
+  //	Objects left over after delivery are kept apart from other left
+  //	over stuff; since entries are numbered in the order they were
+  //	seen, they stay in roughly the order they had in the subject
+  //	and normalizing the remainder is cheaper.
+  //
+  Remainder remainingObjects;
+  int nrEntries = objectMap.size();
+  for (int i = 0; i < nrEntries; ++i)
     {
-      list<DagNode*>& messages = i->second.messages;
+      DagNode* name = objectMap.getName(i);
+      MessageQueue& mq = objectMap.getQueue(i);
+      list<DagNode*>& messages = mq.messages;
       //
       //	If we're doing erewriting, check for external messages
       //	aimed at our object.
       //
-      if (external && rc->getExternalMessages(i->first, messages))
+      if (external && rc->getExternalMessages(name, messages))
 	delivered = true;  // make sure we do a rewrite
 
       for (DagNode* d : messages)
 	{
-	  DagNode* object = i->second.object;
+	  DagNode* object = mq.object;
 	  if (object != 0)
 	    {
 	      dagNodes[0] = object;
@@ -323,8 +333,7 @@ ConfigSymbol::ruleRewrite(DagNode* subject, RewritingContext& context)
 		      if (RewritingContext::getTraceStatus())
 			t->tracePostRuleRewrite(r);
 		      t->reduce();
-		      i->second.object =
-			retrieveObject(t->root(), i->first, remainder);
+		      mq.object = retrieveObject(t->root(), name, remainder);
 		      context.addInCount(*t);
 		      delete t;
 		      continue;  // next message
@@ -339,7 +348,7 @@ ConfigSymbol::ruleRewrite(DagNode* subject, RewritingContext& context)
 	  else
 	    {
 	      DebugAdvisory("unresolved message " << d <<  "  external = " << external);
-	      if (external && rc->offerMessageExternally(i->first, d))
+	      if (external && rc->offerMessageExternally(name, d))
 		{
 		  delivered = true;  // make sure we do a rewrite
 		  continue;  // next message
@@ -353,14 +362,14 @@ ConfigSymbol::ruleRewrite(DagNode* subject, RewritingContext& context)
 	  remainder.multiplicities.append(1);
 	}
       //
-      //	All messages tried; if object still remains, put it into remainder.
+      //	All messages tried; if object still remains, put it aside.
       //
-      DagNode* object = i->second.object;
+      DagNode* object = mq.object;
       if (object != 0)
 	{
 	  DebugInfo("object still remains " << object);
-	  remainder.dagNodes.append(object);
-	  remainder.multiplicities.append(1);
+	  remainingObjects.dagNodes.append(object);
+	  remainingObjects.multiplicities.append(1);
 	}
     }
   if (!delivered)
@@ -370,6 +379,11 @@ ConfigSymbol::ruleRewrite(DagNode* subject, RewritingContext& context)
       ACU_ExtensionInfo extensionInfo(safeCastNonNull<ACU_DagNode*>(subject));
       return leftOverRewrite(subject, context, &extensionInfo);
     }
+  for (DagNode* d : remainingObjects.dagNodes)
+    {
+      remainder.dagNodes.append(d);
+      remainder.multiplicities.append(1);
+    }
   //
   //	Now deal with remainder.
   //
@@ -431,13 +445,18 @@ ConfigSymbol::objMsgRewrite(Symbol* messageSymbol,
 			    DagNode* subject,
 			    RewritingContext& context)
 {
-  RuleSet& rs = ruleMap[messageSymbol];
-  const Vector<Rule*>::const_iterator e = rs.rules.end();
-  for (int tries = rs.rules.length(); tries > 0; --tries)
+  RuleMap::iterator i = ruleMap.find(messageSymbol);
+  if (i == ruleMap.end())
+    return 0;
+  RuleSet& rs = i->second;
+  int nrRules = rs.rules.length();
+  int n = rs.next.load(std::memory_order_relaxed);
+  for (int tries = nrRules; tries > 0; --tries)
     {
-      Rule* rl = *(rs.next);
-      if (++(rs.next) == e)
-	rs.next = rs.rules.begin();
+      Rule* rl = rs.rules[n];
+      if (++n == nrRules)
+	n = 0;
+      rs.next.store(n, std::memory_order_relaxed);
 
       int nrVariables = rl->getNrProtectedVariables();
       context.clear(nrVariables);
@@ -477,12 +496,14 @@ ConfigSymbol::leftOverRewrite(DagNode* subject,
 {
   Assert(subject->getSortIndex() != Sort::SORT_UNKNOWN, "sort unknown");
 
-  const Vector<Rule*>::const_iterator e = leftOver.rules.end();
-  for (int tries = leftOver.rules.length(); tries > 0; --tries)
+  int nrRules = leftOver.rules.length();
+  int n = leftOver.next.load(std::memory_order_relaxed);
+  for (int tries = nrRules; tries > 0; --tries)
     {
-      Rule* rl = *(leftOver.next);
-      if (++(leftOver.next) == e)
-	leftOver.next = leftOver.rules.begin();
+      Rule* rl = leftOver.rules[n];
+      if (++n == nrRules)
+	n = 0;
+      leftOver.next.store(n, std::memory_order_relaxed);
 
       int nrVariables = rl->getNrProtectedVariables();
       context.clear(nrVariables);
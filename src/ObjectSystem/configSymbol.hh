@@ -26,6 +26,7 @@
 #ifndef _configSymbol_hh_
 #define _configSymbol_hh_
 #include <map>
+#include <atomic>
 #include "natSet.hh"
 #include "ACU_Symbol.hh"
 
@@ -60,13 +61,12 @@ private:
   struct RuleSet
   {
     Vector<Rule*> rules;
-    Vector<Rule*>::const_iterator next;
+    std::atomic<int> next;	// fair rewriting may be using us on several threads
   };
 
   typedef map<Symbol*, RuleSet, symbolLt> RuleMap;
 
   struct MessageQueue;
-  struct dagNodeLt;
   class ObjectMap;
   struct Remainder;
 
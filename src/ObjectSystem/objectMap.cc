@@ -22,6 +22,9 @@
 
 //
 //	Map from object identifier to (object, message queue) pairs.
+//	Identifiers are hashed so that each object and message in a
+//	configuration is filed in constant time; entries are numbered in
+//	the order their identifiers were first seen.
 //
 
 struct ConfigSymbol::MessageQueue
@@ -48,44 +51,89 @@ ConfigSymbol::MessageQueue::markReachableNodes() const
     d->mark();
 }
 
-struct ConfigSymbol::dagNodeLt
-{
-  bool operator()(const DagNode* d1, const DagNode* d2) const
-    {
-      return d1->compare(d2) < 0;
-    }
-};
-
-class ConfigSymbol::ObjectMap
- : public map<DagNode*, MessageQueue, dagNodeLt>,
-   private SimpleRootContainer
+class ConfigSymbol::ObjectMap : private SimpleRootContainer
 {
 public:
+  ObjectMap(int sizeHint);
+
+  MessageQueue& operator[](DagNode* name);
+  bool empty() const;
+  int size() const;
+  DagNode* getName(int index) const;
+  MessageQueue& getQueue(int index);
   void dump(ostream& s, int indentLevel = 0);
 
 private:
   void markReachableNodes();
+
+  DagNodeSet names;
+  Vector<MessageQueue> queues;
 };
 
+inline
+ConfigSymbol::ObjectMap::ObjectMap(int sizeHint)
+  : queues(0, sizeHint)
+{
+}
+
+inline ConfigSymbol::MessageQueue&
+ConfigSymbol::ObjectMap::operator[](DagNode* name)
+{
+  int index = names.insert(name);
+  if (index == queues.length())
+    queues.expandBy(1);
+  return queues[index];
+}
+
+inline bool
+ConfigSymbol::ObjectMap::empty() const
+{
+  return queues.empty();
+}
+
+inline int
+ConfigSymbol::ObjectMap::size() const
+{
+  return queues.length();
+}
+
+inline DagNode*
+ConfigSymbol::ObjectMap::getName(int index) const
+{
+  return names.index2DagNode(index);
+}
+
+inline ConfigSymbol::MessageQueue&
+ConfigSymbol::ObjectMap::getQueue(int index)
+{
+  return queues[index];
+}
+
 void
 ConfigSymbol::ObjectMap::markReachableNodes()
 {
-  for (auto& i : *this)
-    i.second.markReachableNodes();
+  int nrEntries = queues.length();
+  for (int i = 0; i < nrEntries; ++i)
+    {
+      names.index2DagNode(i)->mark();
+      queues[i].markReachableNodes();
+    }
 }
 
 void
 ConfigSymbol::ObjectMap::dump(ostream& s, int indentLevel)
 {
   s << Indent(indentLevel) << "begin{ObjectMap}\n";
-  for (auto& i : *this)
+  int nrEntries = queues.length();
+  for (int i = 0; i < nrEntries; ++i)
     {
-      s << Indent(indentLevel + 1) << i.first << '\n';
-      if (i.second.object == 0)
+      s << Indent(indentLevel + 1) << names.index2DagNode(i) << '\n';
+      const MessageQueue& mq = queues[i];
+      if (mq.object == 0)
 	s << Indent(indentLevel + 2) << "*** NO OBJECT ***\n";
       else
-	s << Indent(indentLevel + 2) << i.second.object << '\n';
-      for (DagNode* d : i.second.messages)
+	s << Indent(indentLevel + 2) << mq.object << '\n';
+      for (DagNode* d : mq.messages)
 	s << Indent(indentLevel + 2) << d << '\n';
       s << '\n';
     }
@@ -98,6 +98,21 @@ ObjectSystemRewritingContext::offerMessageExternally(DagNode* target, DagNode* m
   return false;
 }
 
+RewritingContext*
+ObjectSystemRewritingContext::makeFairSubcontext(DagNode* root)
+{
+  //
+  //	External objects belong to us and must only be talked to from
+  //	our thread, so in external mode we keep fair rewriting to ourself.
+  //
+  if (mode == EXTERNAL)
+    return 0;
+  ObjectSystemRewritingContext* c =
+    safeCastNonNull<ObjectSystemRewritingContext*>(makeSubcontext(root, OTHER));
+  c->setObjectMode(mode);
+  return c;
+}
+
 void
 ObjectSystemRewritingContext::markReachableNodes()
 {
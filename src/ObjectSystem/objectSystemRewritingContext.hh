@@ -62,6 +62,7 @@ public:
 
   void setObjectMode(Mode m);
   Mode getObjectMode() const;
+  RewritingContext* makeFairSubcontext(DagNode* root);
 
   void externalRewrite();
 
@@ -0,0 +1,215 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	epoll() based multiplexing of signals and events on file
+//	descriptors. Unlike ppoll() and pselect(), the kernel remembers
+//	the fds we are watching, so we only tell it about fds whose
+//	flags changed since the last call and the cost of a call
+//	depends on the number of fds that are ready rather than the
+//	number being watched. Linux only.
+//
+#include <sys/epoll.h>
+
+int PseudoThread::epollFd = NONE;
+pid_t PseudoThread::epollOwner = 0;
+Vector<int> PseudoThread::changedFds;
+
+void
+PseudoThread::flagsChanged(int fd)
+{
+  //
+  //	We don't update the epoll set straight away since a callback
+  //	often asks for the event it was just called for, leaving the
+  //	flags as they were.
+  //
+  FD_Info& info = fdInfo[fd];
+  if (!info.changed)
+    {
+      info.changed = true;
+      changedFds.append(fd);
+    }
+}
+
+void
+PseudoThread::updateEpollSet()
+{
+  pid_t pid = getpid();
+  if (pid != epollOwner)
+    {
+      //
+      //	Either we haven't made an epoll set yet or we are a child
+      //	that inherited its parent's; since changes to an inherited
+      //	set would be seen by the parent, we make our own and put
+      //	every active fd in it.
+      //
+      if (epollFd != NONE)
+	close(epollFd);
+      epollFd = epoll_create1(EPOLL_CLOEXEC);
+      Assert(epollFd >= 0, "epoll_create1() failed with " << errno);
+      epollOwner = pid;
+      for (FD_Info& info : fdInfo)
+	info.registeredFlags = 0;
+      for (int i = firstActive; i != NONE; i = fdInfo[i].nextActive)
+	flagsChanged(i);
+    }
+
+  for (int fd : changedFds)
+    {
+      FD_Info& info = fdInfo[fd];
+      info.changed = false;
+      if (info.flags == info.registeredFlags)
+	continue;
+      //
+      //	We use level triggered notification since clients are
+      //	not expected to read or write until they would block.
+      //	An fd that closed while registered will have dropped out
+      //	of the set without us being told, so we are forgiving
+      //	about ENOENT and EEXIST.
+      //
+      epoll_event event;
+      event.events = info.flags;
+      event.data.fd = fd;
+      if (info.flags == 0)
+	(void) epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &event);
+      else if (info.registeredFlags == 0)
+	{
+	  if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1 && errno == EEXIST)
+	    (void) epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+	}
+      else
+	{
+	  if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) == -1 && errno == ENOENT)
+	    (void) epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+	}
+      info.registeredFlags = info.flags;
+    }
+  changedFds.clear();
+}
+
+int
+PseudoThread::processFds(const timespec* waitPointer, sigset_t* normalSet)
+{
+  //
+  //	*waitPointer is how long to wait for an event before returning.
+  //	null pointer indicated infinite wait.
+  //
+  //	normalSet is signal mask that corresponds to signals we
+  //	want to be able to interrupt a blocking system call. Some
+  //	of these may be currently blocked to avoid losing the
+  //	signals if they are delivered before the system call happens.
+  //
+  int childEvent = NOTHING_HAPPENED;
+  //
+  //	Block SIGCHLD.
+  //
+  sigset_t oldset;
+  sigset_t newset;
+  sigemptyset(&newset);
+  sigaddset(&newset, SIGCHLD);
+  sigprocmask(SIG_BLOCK, &newset, &oldset);
+  //
+  //	Deal with any child exit notifications that became due.
+  //
+  if (dispatchChildRequests())
+    {
+      childEvent |= EVENT_HANDLED;
+      waitPointer = &zeroTime;  // must not block in epoll_pwait()
+    }
+  updateEpollSet();
+  //
+  //	epoll_pwait() takes a timeout in milliseconds; we round up
+  //	so that we don't wake just before a timed callback is due.
+  //
+  int timeout = -1;
+  if (waitPointer != 0)
+    {
+      Int64 ms = static_cast<Int64>(waitPointer->tv_sec) * 1000 + (waitPointer->tv_nsec + 999999) / 1000000;
+      timeout = (ms > INT_MAX) ? INT_MAX : ms;
+    }
+  //
+  //	Decide on the signals to be atomically unblocked during epoll_pwait().
+  //
+  sigset_t* maskForSystemCall = (normalSet != 0) ? normalSet : &oldset;
+  static epoll_event events[MAX_EVENTS];
+  int nrEvents = epoll_pwait(epollFd, events, MAX_EVENTS, timeout, maskForSystemCall);
+  //
+  //	We restore mask to what it was before we blocked SIGCHLD.
+  //
+  sigprocmask(SIG_SETMASK, &oldset, 0);
+
+  if (nrEvents < 0)
+    {
+      Assert(errno == EINTR, "epoll_pwait() failed with " << errno);
+      return INTERRUPTED;  // treat all errors as interrupts
+    }
+  //
+  //	Deal with the information returned by epoll_pwait(). This
+  //	follows the ppoll() version, except that a ready fd can
+  //	have had its flags cleared by an earlier callback before
+  //	we got around to updating the epoll set.
+  //
+  int returnValue = NOTHING_HAPPENED;
+  for (int i = 0; i < nrEvents; i++)
+    {
+      int fd = events[i].data.fd;
+      FD_Info& info = fdInfo[fd];
+      Uint32 t = events[i].events;
+      if (t & EPOLLERR && info.flags != 0)
+	{
+	  info.flags = 0;
+	  unlink(fd);
+	  flagsChanged(fd);
+	  info.owner->doError(fd);
+	  returnValue = EVENT_HANDLED;
+	  continue;
+	}
+      if (t & EPOLLIN && info.flags & READ)
+	{
+	  info.flags &= ~READ;
+	  if (info.flags == 0)
+	    unlink(fd);
+	  flagsChanged(fd);
+	  info.owner->doRead(fd);
+	  returnValue = EVENT_HANDLED;
+	}
+      else if (t & EPOLLHUP && info.flags != 0)
+	{
+	  info.flags = 0;
+	  unlink(fd);
+	  flagsChanged(fd);
+	  info.owner->doHungUp(fd);
+	  returnValue = EVENT_HANDLED;
+	  continue;
+	}
+      if (t & EPOLLOUT && info.flags & WRITE)
+	{
+	  info.flags &= ~WRITE;
+	  if (info.flags == 0)
+	    unlink(fd);
+	  flagsChanged(fd);
+	  info.owner->doWrite(fd);
+	  returnValue = EVENT_HANDLED;
+	}
+    }
+  return returnValue | childEvent;
+}
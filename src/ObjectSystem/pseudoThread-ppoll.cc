@@ -56,7 +56,9 @@ PseudoThread::processFds(const timespec* waitPointer, sigset_t* normalSet)
       waitPointer = &zeroTime;  // must not block in ppoll()
     }
 
-  static pollfd ufds[MAX_NR_FDS];
+  static Vector<pollfd> ufds;
+  if (ufds.length() <= fdInfo.length())
+    ufds.resize(fdInfo.length() + 1);  // never empty so we can take address of first element
   int nfds = 0;
   //
   //	Construct array of active file descriptors.
@@ -79,7 +81,7 @@ PseudoThread::processFds(const timespec* waitPointer, sigset_t* normalSet)
   //	Decide on the signals to be atomically unblocked during ppoll().
   //
   sigset_t* maskForSystemCall = (normalSet != 0) ? normalSet : &oldset;
-  int nrEvents = ppoll(ufds, nfds, waitPointer, maskForSystemCall);
+  int nrEvents = ppoll(&ufds[0], nfds, waitPointer, maskForSystemCall);
   //
   //	We restore mask to what it was before we blocked SIGCHLD.
   //
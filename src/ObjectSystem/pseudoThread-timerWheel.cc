@@ -0,0 +1,272 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+//
+//	Hierarchical timer wheel for timed callbacks. A timer whose tick
+//	is less than NR_SLOTS^(L+1) ticks ahead of currentTick lives at
+//	level L, in the slot selected by the corresponding digit of its
+//	tick. When currentTick moves into a new slot at level L > 0, the
+//	timers in that slot are cascaded down to lower levels. Requesting
+//	and cancelling a callback take constant time; finding the earliest
+//	pending callback takes time proportional to the number of slots.
+//
+#include <algorithm>
+
+PseudoThread::Timer* PseudoThread::timerWheel[NR_LEVELS][NR_SLOTS];
+int PseudoThread::nrTimersAtLevel[NR_LEVELS];
+Int64 PseudoThread::currentTick = 0;
+Int64 PseudoThread::nrTimers = 0;
+Uint64 PseudoThread::timerSequence = 0;
+
+PseudoThread::CallbackHandle
+PseudoThread::requestCallback(const timespec& notBefore, long clientData)
+{
+  if (nrTimers == 0)
+    {
+      //
+      //	Wheel is empty so we can start it from the current time
+      //	rather than advancing it over the time it was idle.
+      //
+      timespec now;
+      clock_gettime(CLOCK_REALTIME, &now);
+      currentTick = timespecToTick(now);
+    }
+  Timer* timer = new Timer{notBefore, CallbackRequest(this, clientData), timespecToTick(notBefore),
+			   timerSequence++, NONE, 0, 0, 0};
+  insertTimer(timer);
+  ++nrTimers;
+  return timer;
+}
+
+void
+PseudoThread::cancelCallback(const CallbackHandle& handle)
+{
+  Assert(handle->request.client == this, "client mismatch");
+  if (handle->level == NONE)
+    {
+      //
+      //	Timer is due and waiting to be dispatched by processCallbacks();
+      //	it will delete the timer for us.
+      //
+      handle->request.client = 0;
+      return;
+    }
+  removeTimer(handle);
+  --nrTimers;
+  delete handle;
+}
+
+void
+PseudoThread::insertTimer(Timer* timer)
+{
+  Int64 delta = timer->tick - currentTick;
+  Int64 tick = timer->tick;
+  int level = 0;
+  if (delta < 0)
+    tick = currentTick;  // overdue; put it in the slot we will look at next
+  else
+    {
+      while (level < NR_LEVELS - 1 && delta >= (static_cast<Int64>(1) << (SLOT_BITS * (level + 1))))
+	++level;
+      if (delta >= (static_cast<Int64>(1) << (SLOT_BITS * NR_LEVELS)))
+	{
+	  //
+	  //	Beyond the range of the wheel; park it in the furthest slot
+	  //	and it will be put back in its proper place when that slot
+	  //	is cascaded.
+	  //
+	  tick = currentTick + (static_cast<Int64>(1) << (SLOT_BITS * NR_LEVELS)) - 1;
+	}
+    }
+  int slot = (tick >> (SLOT_BITS * level)) & (NR_SLOTS - 1);
+  Timer*& head = timerWheel[level][slot];
+  timer->level = level;
+  timer->slot = slot;
+  timer->prev = 0;
+  timer->next = head;
+  if (head != 0)
+    head->prev = timer;
+  head = timer;
+  ++nrTimersAtLevel[level];
+}
+
+void
+PseudoThread::removeTimer(Timer* timer)
+{
+  int level = timer->level;
+  if (timer->prev != 0)
+    timer->prev->next = timer->next;
+  else
+    timerWheel[level][timer->slot] = timer->next;
+  if (timer->next != 0)
+    timer->next->prev = timer->prev;
+  timer->level = NONE;
+  --nrTimersAtLevel[level];
+}
+
+void
+PseudoThread::cascade(int level)
+{
+  //
+  //	Redistribute the timers in the slot currentTick has just moved
+  //	into at the given level.
+  //
+  int slot = (currentTick >> (SLOT_BITS * level)) & (NR_SLOTS - 1);
+  Timer* timer = timerWheel[level][slot];
+  timerWheel[level][slot] = 0;
+  while (timer != 0)
+    {
+      Timer* next = timer->next;
+      --nrTimersAtLevel[level];
+      insertTimer(timer);
+      timer = next;
+    }
+}
+
+bool
+PseudoThread::processCallbacks(int& returnValue, timespec& wait)
+{
+  //
+  //	We handle any callbacks that are due.
+  //	If there are more callbacks pending we put the relative
+  //	time from now to the earliest of these in wait and return true.
+  //	If there are no callbacks pending we return false.
+  //
+  timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  Int64 nowTick = timespecToTick(now);
+  //
+  //	Collect the timers that are due. The slot for nowTick may also
+  //	hold timers that are due later in the same tick; they stay put
+  //	and currentTick is left at nowTick.
+  //
+  Vector<Timer*> dueTimers;
+  while (currentTick <= nowTick)
+    {
+      int slot = currentTick & (NR_SLOTS - 1);
+      if (slot == 0)
+	{
+	  for (int level = 1; level < NR_LEVELS; ++level)
+	    {
+	      cascade(level);
+	      if (((currentTick >> (SLOT_BITS * level)) & (NR_SLOTS - 1)) != 0)
+		break;
+	    }
+	}
+      for (Timer* timer = timerWheel[0][slot]; timer != 0;)
+	{
+	  Timer* next = timer->next;
+	  if (!(now < timer->notBefore))
+	    {
+	      removeTimer(timer);
+	      dueTimers.append(timer);
+	    }
+	  timer = next;
+	}
+      if (currentTick == nowTick)
+	break;
+      if (nrTimersAtLevel[0] == 0)
+	{
+	  //
+	  //	Nothing can happen until the next cascade so skip ahead.
+	  //
+	  Int64 nextCascade = (currentTick | (NR_SLOTS - 1)) + 1;
+	  currentTick = (nextCascade < nowTick) ? nextCascade : nowTick;
+	}
+      else
+	++currentTick;
+    }
+  //
+  //	Dispatch due timers in time order. A callback may cancel a
+  //	timer that is waiting to be dispatched, in which case its
+  //	client will have been cleared.
+  //
+  sort(dueTimers.begin(), dueTimers.end(), [](const Timer* t1, const Timer* t2)
+       {
+	 if (t1->notBefore < t2->notBefore)
+	   return true;
+	 if (t2->notBefore < t1->notBefore)
+	   return false;
+	 return t1->sequence < t2->sequence;
+       });
+  for (Timer* timer : dueTimers)
+    {
+      PseudoThread* client = timer->request.client;
+      long clientData = timer->request.clientData;
+      delete timer;
+      --nrTimers;
+      if (client != 0)
+	{
+	  client->doCallback(clientData);
+	  returnValue |= EVENT_HANDLED;
+	}
+    }
+
+  timespec expiry;
+  if (nextTimerExpiry(expiry))
+    {
+      clock_gettime(CLOCK_REALTIME, &now);
+      if (now < expiry)
+	timespecSubtract(expiry, now, wait);
+      else
+	wait = zeroTime;
+      return true;
+    }
+  return false;
+}
+
+bool
+PseudoThread::nextTimerExpiry(timespec& expiry)
+{
+  //
+  //	At each level, the first nonempty slot after the current one
+  //	holds that level's earliest timers; the current slot comes
+  //	last since at levels above 0 anything in it is a whole
+  //	rotation ahead.
+  //
+  if (nrTimers == 0)
+    return false;
+  bool found = false;
+  for (int level = 0; level < NR_LEVELS; ++level)
+    {
+      if (nrTimersAtLevel[level] == 0)
+	continue;
+      int current = (currentTick >> (SLOT_BITS * level)) & (NR_SLOTS - 1);
+      for (int i = (level == 0) ? 0 : 1; i <= NR_SLOTS; ++i)
+	{
+	  Timer* timer = timerWheel[level][(current + i) & (NR_SLOTS - 1)];
+	  if (timer != 0)
+	    {
+	      for (; timer != 0; timer = timer->next)
+		{
+		  if (!found || timer->notBefore < expiry)
+		    {
+		      expiry = timer->notBefore;
+		      found = true;
+		    }
+		}
+	      break;
+	    }
+	}
+    }
+  return found;
+}
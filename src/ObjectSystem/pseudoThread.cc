@@ -32,15 +32,20 @@
 
 //	our stuff
 #include "pseudoThreadSignal.cc"
-#ifdef HAVE_PPOLL
+#ifdef USE_EPOLL
+#include "pseudoThread-epoll.cc"
+#include "pseudoThread-timerWheel.cc"
+#elif defined(HAVE_PPOLL)
 #include "pseudoThread-ppoll.cc"
 #else
 #include "pseudoThread-pselect.cc"
 #endif
 
 const timespec PseudoThread::zeroTime = {0, 0};
-PseudoThread::FD_Info PseudoThread::fdInfo[MAX_NR_FDS];
+Vector<PseudoThread::FD_Info> PseudoThread::fdInfo;
 int PseudoThread::firstActive = NONE;
+
+#ifndef USE_EPOLL
 PseudoThread::CallbackMap PseudoThread::callbackMap;
 
 PseudoThread::CallbackHandle
@@ -88,6 +93,7 @@ PseudoThread::processCallbacks(int& returnValue, timespec& wait)
   while (!(callbackMap.empty()));
   return false;
 }
+#endif
 
 int
 PseudoThread::eventLoop(bool block, sigset_t* normalSet)
@@ -111,7 +117,11 @@ PseudoThread::eventLoop(bool block, sigset_t* normalSet)
       //
       timespec wait;
       bool callbacksPending = false;
+#ifdef USE_EPOLL
+      if (nrTimers != 0)
+#else
       if (!(callbackMap.empty()))
+#endif
 	{
 	  //
 	  //	See if any timed callbacks can be handled and
@@ -195,10 +205,13 @@ PseudoThread::clearFlags(int fd)
   //
   //	Forget about this file descriptor.
   //
-  if (fdInfo[fd].flags != 0)
+  if (fd < fdInfo.length() && fdInfo[fd].flags != 0)
     {
       fdInfo[fd].flags = 0;
       unlink(fd);
+#ifdef USE_EPOLL
+      flagsChanged(fd);
+#endif
     }
 }
 
@@ -206,15 +219,44 @@ void
 PseudoThread::wantTo(int flags, int fd)
 {
   Assert(flags != 0, "empty flags for " << fd);
+  int oldSize = fdInfo.length();
+  if (fd >= oldSize)
+    {
+      //
+      //	First time we've seen an fd this big.
+      //
+      fdInfo.resize(fd + 1);
+      for (int i = oldSize; i <= fd; ++i)
+	{
+	  FD_Info& info = fdInfo[i];
+	  info.owner = 0;
+	  info.flags = 0;
+#ifdef USE_EPOLL
+	  info.registeredFlags = 0;
+	  info.changed = false;
+#endif
+	}
+    }
   int t = fdInfo[fd].flags;
   if (t == 0)
     {
       link(fd);
       fdInfo[fd].owner = this;
+#ifdef USE_EPOLL
+      //
+      //	The fd may have been closed and reopened since we last
+      //	registered it, in which case the kernel will have forgotten it.
+      //
+      if (fdInfo[fd].registeredFlags != 0)
+	fdInfo[fd].registeredFlags = UNKNOWN_REGISTRATION;
+#endif
     }
   else
     Assert(fdInfo[fd].owner == this, "owner mismatch for " << fd);
   fdInfo[fd].flags = t | flags;
+#ifdef USE_EPOLL
+  flagsChanged(fd);
+#endif
 }
 
 void
@@ -44,6 +44,13 @@ private:
     long clientData;
   };
 
+#ifdef USE_EPOLL
+  //
+  //	Timed callbacks are kept in a hierarchical timer wheel so that
+  //	requesting and cancelling them takes constant time.
+  //
+  struct Timer;
+#else
   //
   //	We would prefer to use priority_queue<> to have constant
   //	time access to the least element, but this template
@@ -51,9 +58,14 @@ private:
   //	request cancellation.
   //
   typedef multimap<timespec, CallbackRequest> CallbackMap;
+#endif
 
 public:
+#ifdef USE_EPOLL
+  typedef Timer* CallbackHandle;
+#else
   typedef CallbackMap::iterator CallbackHandle;
+#endif
 
   PseudoThread() {}
 
@@ -141,17 +153,16 @@ public:
   virtual void doChildExit(pid_t childPid);
 
 private:
-  enum Values
-  {
-    MAX_NR_FDS = 1024
-  };
-
   struct FD_Info
   {
     PseudoThread* owner;  // only one owner allowed per fd
     short flags;
-    short nextActive;  // maintain a linked list of active fds (those with non-zero flags)
-    short prevActive;
+#ifdef USE_EPOLL
+    short registeredFlags;  // events we last asked epoll to report, or UNKNOWN_REGISTRATION
+    bool changed;  // on changedFds list
+#endif
+    int nextActive;  // maintain a linked list of active fds (those with non-zero flags)
+    int prevActive;
   };
 
 
@@ -169,6 +180,30 @@ private:
   static int processFds(const timespec* waitPointer, sigset_t* normalSet);
   static void link(int fd);
   static void unlink(int fd);
+#ifdef USE_EPOLL
+  enum EpollParameters
+  {
+    MAX_EVENTS = 256,		// events fetched by one epoll_pwait() call
+    UNKNOWN_REGISTRATION = -1	// registeredFlags value when we don't know if the kernel still has the fd
+  };
+
+  static void flagsChanged(int fd);
+  static void updateEpollSet();
+
+  enum TimerWheelParameters
+  {
+    TICK_NSEC = 1000000,	// 1ms resolution
+    SLOT_BITS = 8,
+    NR_SLOTS = 1 << SLOT_BITS,
+    NR_LEVELS = 4		// covers 2^32 ticks; later timers are clamped and recascaded
+  };
+
+  static Int64 timespecToTick(const timespec& t);
+  static void insertTimer(Timer* timer);
+  static void removeTimer(Timer* timer);
+  static void cascade(int level);
+  static bool nextTimerExpiry(timespec& expiry);
+#endif
 
   static void sigchldHandler(int signalNr, siginfo_t* info, void* context);
   static bool dispatchChildRequests();
@@ -177,9 +212,24 @@ private:
   //	a common set of fds and a global callback map.
   //
   static const timespec zeroTime;
-  static FD_Info fdInfo[MAX_NR_FDS];
+  static Vector<FD_Info> fdInfo;
   static int firstActive;
+#ifdef USE_EPOLL
+  static int epollFd;
+  static pid_t epollOwner;  // epoll sets are shared with forked children, so each process makes its own
+  static Vector<int> changedFds;  // fds whose flags may differ from what epoll is watching
+  //
+  //	Timer wheel; level 0 has a slot for each tick and each slot at
+  //	level L covers NR_SLOTS ticks at level L - 1.
+  //
+  static Timer* timerWheel[NR_LEVELS][NR_SLOTS];
+  static int nrTimersAtLevel[NR_LEVELS];
+  static Int64 currentTick;  // ticks before this one have been processed
+  static Int64 nrTimers;
+  static Uint64 timerSequence;
+#else
   static CallbackMap callbackMap;
+#endif
   //
   //	Data for handling SIGCHLD.
   //
@@ -195,6 +245,26 @@ PseudoThread::CallbackRequest::CallbackRequest(PseudoThread* client, long client
 {
 }
 
+#ifdef USE_EPOLL
+struct PseudoThread::Timer
+{
+  timespec notBefore;
+  CallbackRequest request;
+  Int64 tick;
+  Uint64 sequence;  // so that timers with the same time fire in the order they were requested
+  int level;  // NONE if not in the wheel
+  int slot;
+  Timer* prev;
+  Timer* next;
+};
+
+inline Int64
+PseudoThread::timespecToTick(const timespec& t)
+{
+  return static_cast<Int64>(t.tv_sec) * (1000000000L / TICK_NSEC) + t.tv_nsec / TICK_NSEC;
+}
+#endif
+
 inline
 PseudoThread::ChildRequest::ChildRequest(PseudoThread* client, pid_t pid)
   : client(client),
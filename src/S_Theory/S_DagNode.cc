@@ -53,15 +53,67 @@
 
 S_DagNode::S_DagNode(S_Symbol* symbol, const mpz_class& number, DagNode* arg)
   : DagNode(symbol),
-    number(new mpz_class(number)),
     arg(arg)
 {
-  setCallDtor();  // need our dtor called when garbage collected to destruct number
+  if (number.fits_slong_p())
+    {
+      smallNumber = number.get_si();
+      setTheoryByte(SMALL);
+    }
+  else
+    {
+      bigNumber = new mpz_class(number);
+      setTheoryByte(BIG);
+      setCallDtor();  // need our dtor called when garbage collected to destruct number
+    }
+}
+
+S_DagNode::S_DagNode(S_Symbol* symbol, Int64 number, DagNode* arg)
+  : DagNode(symbol),
+    arg(arg)
+{
+  if (number >= LONG_MIN && number <= LONG_MAX)
+    {
+      smallNumber = number;
+      setTheoryByte(SMALL);
+    }
+  else
+    {
+      //
+      //	Only possible where long is narrower than Int64.
+      //
+      bigNumber = new mpz_class;
+      mpz_import(bigNumber->get_mpz_t(), 1, 1, sizeof(number), 0, 0, &number);
+      setTheoryByte(BIG);
+      setCallDtor();
+    }
+}
+
+S_DagNode::S_DagNode(S_Symbol* symbol, const S_DagNode* other, DagNode* arg)
+  : DagNode(symbol),
+    arg(arg)
+{
+  if (other->isSmall())
+    {
+      smallNumber = other->smallNumber;
+      setTheoryByte(SMALL);
+    }
+  else
+    {
+      bigNumber = new mpz_class(*(other->bigNumber));
+      setTheoryByte(BIG);
+      setCallDtor();
+    }
 }
 
 S_DagNode::~S_DagNode()
 {
-  delete number;
+  //
+  //	Once set, the dtor flag stays set if we shrink back to a small
+  //	number in place.
+  //
+  if (!isSmall())
+    delete bigNumber;
 }
 
 RawDagArgumentIterator*
@@ -75,14 +127,20 @@ S_DagNode::getHashValue()
 {
   return hash(symbol()->getHashValue(),
 	      arg->getHashValue(),
-	      mpz_tdiv_ui(number->get_mpz_t(), INT_MAX));
+	      isSmall() ? smallNumber % INT_MAX : mpz_tdiv_ui(bigNumber->get_mpz_t(), INT_MAX));
 }
 
 int
 S_DagNode::compareArguments(const DagNode* other) const
 {
   const S_DagNode* d = safeCast(const S_DagNode*, other);
-  int r = cmp(*number, *(d->number));
+  if (isSmall() && d->isSmall())
+    {
+      if (smallNumber != d->smallNumber)
+	return (smallNumber < d->smallNumber) ? -1 : 1;
+      return arg->compare(d->arg);
+    }
+  int r = cmp(getNumber(), d->getNumber());
   return (r == 0) ? arg->compare(d->arg) : r;
 }
 
@@ -97,13 +155,13 @@ S_DagNode::copyEagerUptoReduced2()
 {
   S_Symbol* s = symbol();
   DagNode* argCopy = (s->standardStrategy()) ? arg->copyEagerUptoReduced() : arg;
-  return new S_DagNode(s, *number, argCopy);
+  return new S_DagNode(s, this, argCopy);
 }
 
 DagNode*
 S_DagNode::copyAll2()
 {
-  return new S_DagNode(symbol(), *number, arg->copyAll());
+  return new S_DagNode(symbol(), this, arg->copyAll());
 }
 
 void
@@ -115,7 +173,7 @@ S_DagNode::clearCopyPointers2()
 void
 S_DagNode::overwriteWithClone(DagNode* old)
 {
-  S_DagNode* d = new(old) S_DagNode(symbol(), *number, arg);
+  S_DagNode* d = new(old) S_DagNode(symbol(), this, arg);
   d->copySetRewritingFlags(this);
   d->setSortIndex(getSortIndex());
 }
@@ -123,7 +181,7 @@ S_DagNode::overwriteWithClone(DagNode* old)
 DagNode*
 S_DagNode::makeClone()
 {
-  S_DagNode* d = new S_DagNode(symbol(), *number, arg);
+  S_DagNode* d = new S_DagNode(symbol(), this, arg);
   d->copySetRewritingFlags(this);
   d->setSortIndex(getSortIndex());
   return d;
@@ -134,17 +192,57 @@ S_DagNode::normalizeAtTop()
 {
   if (arg->symbol() == symbol())
     {
+      MemoryCell::writeBarrier(this);
       S_DagNode* a = safeCast(S_DagNode*, arg);
-      *number += *(a->number);
+      addNumber(a);
       arg = a->arg;
     }
 }
 
+void
+S_DagNode::setNumber(const mpz_class& newNumber)
+{
+  if (newNumber.fits_slong_p())
+    {
+      if (!isSmall())
+	{
+	  delete bigNumber;
+	  setTheoryByte(SMALL);
+	}
+      smallNumber = newNumber.get_si();
+    }
+  else if (isSmall())
+    {
+      bigNumber = new mpz_class(newNumber);
+      setTheoryByte(BIG);
+      setCallDtor();
+    }
+  else
+    *bigNumber = newNumber;
+}
+
+void
+S_DagNode::addNumber(const S_DagNode* other)
+{
+  if (isSmall() && other->isSmall())
+    {
+      long sum;
+      if (!__builtin_add_overflow(static_cast<long>(smallNumber),
+				  static_cast<long>(other->smallNumber),
+				  &sum))
+	{
+	  smallNumber = sum;
+	  return;
+	}
+    }
+  setNumber(getNumber() + other->getNumber());
+}
+
 DagNode*
 S_DagNode::copyWithReplacement(int argIndex, DagNode* replacement)
 {
   Assert(argIndex == 0, "bad arg index");
-  return new S_DagNode(symbol(), *number, replacement);
+  return new S_DagNode(symbol(), this, replacement);
 }
 
 DagNode*
@@ -153,13 +251,14 @@ S_DagNode::copyWithReplacement(Vector<RedexPosition>& redexStack,
 			       int last)
 {
   Assert(first == last, "nrArgs clash");
-  return new S_DagNode(symbol(), *number, redexStack[first].node());
+  return new S_DagNode(symbol(), this, redexStack[first].node());
 }
 
 void
 S_DagNode::partialReplace(DagNode* replacement, ExtensionInfo* extensionInfo)
 {
-  *number = safeCast(S_ExtensionInfo*, extensionInfo)->getUnmatched();
+  MemoryCell::writeBarrier(this);
+  setNumber(safeCast(S_ExtensionInfo*, extensionInfo)->getUnmatched());
   arg = replacement;
   repudiateSortInfo();
 }
@@ -192,7 +291,7 @@ S_DagNode::matchVariableWithExtension(int index,
   //
   returnedSubproblem =
     new S_Subproblem(this,
-		     *number,
+		     getNumber(),
 		     index,
 		     sort,
 		     safeCast(S_ExtensionInfo*, extensionInfo),
@@ -223,7 +322,7 @@ S_DagNode::computeSolvedForm2(DagNode* rhs, UnificationContext& solution, Pendin
   if (s == rhs->symbol())
     {
       S_DagNode* rhs2 = safeCast(S_DagNode*, rhs);
-      mpz_class diff = *(rhs2->number) - *number;
+      mpz_class diff = rhs2->getNumber() - getNumber();
       if (diff == 0)
 	return arg->computeSolvedForm(rhs2->arg, solution, pending);
       //
@@ -275,7 +374,7 @@ S_DagNode::computeSolvedForm2(DagNode* rhs, UnificationContext& solution, Pendin
 	  //	solution.unificationBind(abstractionVariable, arg) not safe since arg might be impure.
 	  //
 	  arg->computeSolvedForm(abstractionVariable, solution, pending);
-	  purified = new S_DagNode(s, *number, abstractionVariable);
+	  purified = new S_DagNode(s, this, abstractionVariable);
 	}
       solution.unificationBind(r, purified);
       return true;
@@ -294,7 +393,7 @@ S_DagNode::instantiate2(const Substitution& substitution, bool maintainInvariant
 {
   if (DagNode* n = arg->instantiate(substitution, maintainInvariants))
     {
-      mpz_class num = *number;
+      mpz_class num = getNumber();
       S_Symbol* s = symbol();
       if (maintainInvariants && s == n->symbol())
 	{
@@ -303,7 +402,7 @@ S_DagNode::instantiate2(const Substitution& substitution, bool maintainInvariant
 	  //	to do theory normalization.
 	  //
 	  S_DagNode* t = safeCast(S_DagNode*, n);
-	  num += *(t->number);
+	  num += t->getNumber();
 	  n = t->arg;
 	}
       DagNode* d =  new S_DagNode(s, num, n);
@@ -329,7 +428,7 @@ S_DagNode::instantiateWithReplacement(const Substitution& /* substitution */,
 				      DagNode* newDag)
 {
   Assert(argIndex == 0, "bad arg index");
-  return new S_DagNode(symbol(), *number, newDag);
+  return new S_DagNode(symbol(), this, newDag);
 }
 
 DagNode*
@@ -341,7 +440,7 @@ S_DagNode::instantiateWithCopies2(const Substitution& substitution, const Vector
     arg->instantiate(substitution, false); 
   if (n != 0)
     {
-      mpz_class num = *number;
+      mpz_class num = getNumber();
       if (s == n->symbol())
 	{
 	  //
@@ -349,7 +448,7 @@ S_DagNode::instantiateWithCopies2(const Substitution& substitution, const Vector
 	  //	to do theory normalization.
 	  //
 	  S_DagNode* t = safeCast(S_DagNode*, n);
-	  num += *(t->number);
+	  num += t->getNumber();
 	  n = t->arg;
 	}
       DagNode* d =  new S_DagNode(s, num, n);
@@ -23,6 +23,11 @@
 //
 //	Class for DAG nodes in the successor theory.
 //
+//	Iteration counts that fit in a long are held inline; only larger ones
+//	need a heap allocated mpz_class and a dtor call when garbage collected.
+//	The representation is canonical so equal counts are always held the
+//	same way.
+//
 #ifndef _S_DagNode_hh_
 #define _S_DagNode_hh_
 #include "gmpxx.h"
@@ -34,6 +39,7 @@ class S_DagNode : public DagNode
 
 public:
   S_DagNode(S_Symbol* symbol, const mpz_class& number, DagNode* arg);
+  S_DagNode(S_Symbol* symbol, Int64 number, DagNode* arg);
   ~S_DagNode();
   //
   //	Functions required by theory interface.
@@ -78,10 +84,22 @@ public:
   //	Functions specific to S_DagNode.
   //
   S_Symbol* symbol() const;
-  const mpz_class& getNumber() const;
+  mpz_class getNumber() const;
+  bool isSmall() const;
+  Int64 getSmallNumber() const;
   DagNode* getArgument() const;
 
 private:
+  enum Representation
+  {
+    SMALL,
+    BIG
+  };
+  //
+  //	Makes a node with the same iteration count as other.
+  //
+  S_DagNode(S_Symbol* symbol, const S_DagNode* other, DagNode* arg);
+
   //
   //	Functions required by theory interface.
   //
@@ -93,8 +111,17 @@ private:
   //	Normalization functions.
   //
   void normalizeAtTop();
-
-  mpz_class* number;
+  //
+  //	Functions for changing the iteration count in place.
+  //
+  void setNumber(const mpz_class& newNumber);
+  void addNumber(const S_DagNode* other);
+
+  union
+  {
+    Int64 smallNumber;
+    mpz_class* bigNumber;
+  };
   DagNode* arg;
   
   friend class S_Symbol;           	// to reduce subterms prior to rewrite, normalization
@@ -106,10 +133,23 @@ S_DagNode::symbol() const
   return safeCast(S_Symbol*, DagNode::symbol());
 }
 
-inline const mpz_class&
+inline bool
+S_DagNode::isSmall() const
+{
+  return getTheoryByte() == SMALL;
+}
+
+inline Int64
+S_DagNode::getSmallNumber() const
+{
+  Assert(isSmall(), "big number");
+  return smallNumber;
+}
+
+inline mpz_class
 S_DagNode::getNumber() const
 {
-  return *number;
+  return isSmall() ? mpz_class(static_cast<long>(smallNumber)) : *bigNumber;
 }
 
 inline DagNode*
@@ -56,6 +56,7 @@ S_LhsAutomaton::S_LhsAutomaton(S_Symbol* symbol,
 			       bool matchAtTop)
   : topSymbol(symbol),
     number(number),
+    smallNumber(number.fits_slong_p() ? number.get_si() : 0),
     matchAtTop(matchAtTop)
 {
 }
@@ -137,13 +138,12 @@ S_LhsAutomaton::matchEq(DagNode* arg,
 local_inline bool
 S_LhsAutomaton::nonExtMatchGt(DagNode* subject,
 			      DagNode* arg,
-			      const mpz_class& subjectNumber,
+			      const mpz_class& diff,
 			      Substitution& solution,
 			      Subproblem*& returnedSubproblem)
 {
   if (type == GROUND_ALIEN || type == NON_GROUND_ALIEN)
     return false;  // nothing to absort extra iter operators
-  mpz_class diff = subjectNumber - number;
   if (type == VARIABLE)
     {
       //
@@ -159,7 +159,43 @@ S_LhsAutomaton::nonExtMatchGt(DagNode* subject,
 	    value->getArgument()->equal(arg);
 	}
     }
-  S_DagNode* d = new S_DagNode(topSymbol, diff, arg);
+  return bindDifference(subject, new S_DagNode(topSymbol, diff, arg), solution, returnedSubproblem);
+}
+
+local_inline bool
+S_LhsAutomaton::nonExtMatchGt(DagNode* subject,
+			      DagNode* arg,
+			      Int64 diff,
+			      Substitution& solution,
+			      Subproblem*& returnedSubproblem)
+{
+  if (type == GROUND_ALIEN || type == NON_GROUND_ALIEN)
+    return false;  // nothing to absort extra iter operators
+  if (type == VARIABLE)
+    {
+      //
+      //	Need to check for and handle the bound variable case. Since
+      //	representations are canonical a big number can't equal diff.
+      //
+      if (DagNode* d = solution.value(varIndex))
+	{
+	  if (d->symbol() != topSymbol)
+	    return false;
+	  S_DagNode* value = safeCast(S_DagNode*, d);
+	  returnedSubproblem = 0;
+	  return value->isSmall() && value->getSmallNumber() == diff &&
+	    value->getArgument()->equal(arg);
+	}
+    }
+  return bindDifference(subject, new S_DagNode(topSymbol, diff, arg), solution, returnedSubproblem);
+}
+
+local_inline bool
+S_LhsAutomaton::bindDifference(DagNode* subject,
+			       S_DagNode* d,
+			       Substitution& solution,
+			       Subproblem*& returnedSubproblem)
+{
   solution.bind(varIndex, d);  // to protect new dag node
   if (type == ABSTRACTED_NON_GROUND_ALIEN)
     return automaton->match(d, solution, returnedSubproblem);
@@ -278,7 +314,19 @@ S_LhsAutomaton::match(DagNode* subject,
     return false;
   Assert(matchAtTop == (extensionInfo != 0), "matchAtTop disagreement");
   S_DagNode* s = static_cast<S_DagNode*>(subject);
-  const mpz_class& subjectNumber = s->getNumber();
+  if (!matchAtTop && smallNumber != 0 && s->isSmall())
+    {
+      //
+      //	Common case where both iteration counts fit in a long.
+      //
+      Int64 subjectNumber = s->getSmallNumber();
+      if (subjectNumber < smallNumber)
+	return false;
+      DagNode* arg = s->getArgument();
+      return (subjectNumber == smallNumber) ? matchEq(arg, solution, returnedSubproblem) :
+	nonExtMatchGt(subject, arg, subjectNumber - smallNumber, solution, returnedSubproblem);
+    }
+  mpz_class subjectNumber = s->getNumber();
   //
   //	The basic idea is that we can peel "number" iter operators off the subject or
   //	else we fail. If the subject is now out of theory we have a straight forward
@@ -309,7 +357,7 @@ S_LhsAutomaton::match(DagNode* subject,
   else
     {
       return (r == 0) ? matchEq(arg, solution, returnedSubproblem) :
-	nonExtMatchGt(subject, arg, subjectNumber, solution, returnedSubproblem);
+	nonExtMatchGt(subject, arg, mpz_class(subjectNumber - number), solution, returnedSubproblem);
     }
   return false;
 }
@@ -67,9 +67,18 @@ private:
 	       Subproblem*& returnedSubproblem);
   bool nonExtMatchGt(DagNode* subject,
 		     DagNode* arg,
-		     const mpz_class& subjectNumber,
+		     const mpz_class& diff,
 		     Substitution& solution,
 		     Subproblem*& returnedSubproblem);
+  bool nonExtMatchGt(DagNode* subject,
+		     DagNode* arg,
+		     Int64 diff,
+		     Substitution& solution,
+		     Subproblem*& returnedSubproblem);
+  bool bindDifference(DagNode* subject,
+		      S_DagNode* difference,
+		      Substitution& solution,
+		      Subproblem*& returnedSubproblem);
   bool extMatchGt(S_DagNode* subject,
 		  DagNode* arg,
 		  const mpz_class& subjectNumber,
@@ -79,6 +88,7 @@ private:
 
   S_Symbol* const topSymbol;
   const mpz_class number;
+  const Int64 smallNumber;	// number if it fits in a long, 0 otherwise
   const bool matchAtTop;
   //
   //	Stuff for argument.
@@ -260,7 +260,9 @@ S_Symbol::computeBaseSort(DagNode* subject)
   S_DagNode* s = safeCast(S_DagNode*, subject);
   int argSortIndex = s->getArgument()->getSortIndex();
   Assert(argSortIndex != Sort::SORT_UNKNOWN, "unknown sort");
-  subject->setSortIndex(sortPathTable[argSortIndex].computeSortIndex(s->getNumber()));
+  SortPath& path = sortPathTable[argSortIndex];
+  subject->setSortIndex(s->isSmall() ? path.computeSortIndex(s->getSmallNumber()) :
+			path.computeSortIndex(s->getNumber()));
 }
 
 void
@@ -281,8 +283,8 @@ S_Symbol::isConstructor(DagNode* subject)
   const SortPath& path = sortPathTable[s->arg->getSortIndex()];
   if (path.nonCtorBound == NONE)
     return true;
-  const mpz_class& number = *(s->number);
-  return number <= path.nonCtorBound;
+  return s->isSmall() ? s->getSmallNumber() <= path.nonCtorBound :
+    s->getNumber() <= path.nonCtorBound;
 }
 
 void
@@ -524,7 +526,7 @@ S_Symbol::makeCanonical(DagNode* original, HashConsSet* hcs)
   //
   //	Need to make new node.
   //
-  S_DagNode* n = new S_DagNode(this, s->getNumber(), c);
+  S_DagNode* n = new S_DagNode(this, s, c);
   n->copySetRewritingFlags(original);
   n->setSortIndex(original->getSortIndex());
   return n;
@@ -538,7 +540,7 @@ S_Symbol::makeCanonicalCopy(DagNode* original, HashConsSet* hcs)
   //
   S_DagNode* s = safeCast(S_DagNode*, original);
   DagNode* c = hcs->getCanonical(hcs->insert(s->getArgument()));
-  S_DagNode* n = new S_DagNode(this, s->getNumber(), c);
+  S_DagNode* n = new S_DagNode(this, s, c);
   n->copySetRewritingFlags(original);
   n->setSortIndex(original->getSortIndex());
   return n;
@@ -82,6 +82,7 @@ private:
   struct SortPath
   {
     int computeSortIndex(const mpz_class& number);
+    int computeSortIndex(Int64 number);
 
     Vector<int> sortIndices;
     int leadLength;
@@ -113,4 +114,14 @@ S_Symbol::SortPath::computeSortIndex(const mpz_class& number)
   return sortIndices[leadLength + remainder];
 }
 
+inline int
+S_Symbol::SortPath::computeSortIndex(Int64 number)
+{
+  int pathLength = sortIndices.length();
+  if (number <= pathLength)
+    return sortIndices[number - 1];
+  int cycleLength = pathLength - leadLength;
+  return sortIndices[leadLength + (number - (leadLength + 1)) % cycleLength];
+}
+
 #endif
@@ -54,6 +54,7 @@ public:
   int makeProp(int propIndex);
   int makeOp(Op op, int firstArg = NONE, int secondArg = NONE);
 
+  int getNrNodes() const;
   int getProp(int nodeNr) const;
   Op getOp(int nodeNr) const;
   int getArg(int nodeNr, int argNr = 0) const;
@@ -77,6 +78,12 @@ private:
   Vector<Node> nodes;
 };
 
+inline int
+LogicFormula::getNrNodes() const
+{
+  return nodes.length();
+}
+
 inline LogicFormula::Op
 LogicFormula::getOp(int nodeNr) const
 {
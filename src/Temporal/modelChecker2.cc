@@ -32,6 +32,7 @@
 #include "temporal.hh"
 
 //      utility class definitions
+#include "logicFormula.hh"
 #include "modelChecker2.hh"
 
 ModelChecker2::ModelChecker2(System& system, LogicFormula& property, int top)
@@ -40,12 +41,34 @@ ModelChecker2::ModelChecker2(System& system, LogicFormula& property, int top)
 {
   Verbose("ModelChecker: Property automaton has " <<
 	  propertyAutomaton.getNrStates() << " states.");
+  //
+  //	Work out the layout of the per system state bit vectors.
+  //
+  int nrPropositions = 0;
+  int nrNodes = property.getNrNodes();
+  for (int i = 0; i < nrNodes; ++i)
+    {
+      if (property.getOp(i) == LogicFormula::PROPOSITION)
+	{
+	  int propIndex = property.getProp(i);
+	  if (propIndex >= nrPropositions)
+	    nrPropositions = propIndex + 1;
+	}
+    }
+  int propertyStateWords = (propertyAutomaton.getNrStates() + BITS_PER_WORD - 1) / BITS_PER_WORD;
+  int propositionWords = (nrPropositions + BITS_PER_WORD - 1) / BITS_PER_WORD;
+  wordsPerState = 0;
+  for (int i = 0; i < NR_FIELDS; ++i)
+    {
+      fieldStart[i] = wordsPerState;
+      wordsPerState += (i < TESTED_PROPS) ? propertyStateWords : propositionWords;
+    }
 }
 
 bool
 ModelChecker2::findCounterexample()
 {
-  intersectionStates.expandTo(1);
+  ensureState(0);
   const NatSet& initialStates = propertyAutomaton.getInitialStates();
   const NatSet::const_iterator e = initialStates.end();
   for (NatSet::const_iterator i = initialStates.begin(); i != e; ++i)
@@ -64,14 +87,13 @@ ModelChecker2::findCounterexample()
 local_inline bool
 ModelChecker2::dfs1SystemTransitions(int systemStateNr, int propertyStateNr)
 {
-  intersectionStates[systemStateNr].dfs1Seen.insert(propertyStateNr);
+  insert(getField(systemStateNr, DFS1_SEEN), propertyStateNr);
   for (int i = 0;; i++)
     {
       int n = system.getNextState(systemStateNr, i);
       if (n == NONE)
 	break;
-      if (n >= intersectionStates.length())
-	intersectionStates.expandTo(n + 1);
+      ensureState(n);
       if (dfs1PropertyTransitions(n, propertyStateNr))
 	return true;
     }
@@ -89,10 +111,9 @@ ModelChecker2::dfs1PropertyTransitions(int systemStateNr, int propertyStateNr)
       if (satisfiesPropositionalFormula(systemStateNr, i->second))
 	{
 	  int newPropertyStateNr = i->first;
-	  StateSet& s = intersectionStates[systemStateNr];
-	  if (!(s.dfs1Seen.contains(newPropertyStateNr)))
+	  if (!contains(getField(systemStateNr, DFS1_SEEN), newPropertyStateNr))
 	    {
-	      s.onDfs1Stack.insert(newPropertyStateNr);
+	      insert(getField(systemStateNr, ON_DFS1_STACK), newPropertyStateNr);
 	      if (dfs1SystemTransitions(systemStateNr, newPropertyStateNr) ||
 		  (propertyAutomaton.isAccepting(newPropertyStateNr) &&
 		   dfs2SystemTransitions(systemStateNr, newPropertyStateNr)))
@@ -103,7 +124,7 @@ ModelChecker2::dfs1PropertyTransitions(int systemStateNr, int propertyStateNr)
 		    cycle.swap(path);
 		  return true;
 		}
-	      intersectionStates[systemStateNr].onDfs1Stack.subtract(newPropertyStateNr);
+	      subtract(getField(systemStateNr, ON_DFS1_STACK), newPropertyStateNr);
 	    }
 	}
     }
@@ -127,14 +148,13 @@ ModelChecker2::dfs2PropertyTransitions(int systemStateNr, int propertyStateNr)
       if (satisfiesPropositionalFormula(systemStateNr, i->second))
 	{
 	  int newPropertyStateNr = i->first;
-	  StateSet& s = intersectionStates[systemStateNr];
-	  if (s.onDfs1Stack.contains(newPropertyStateNr))
+	  if (contains(getField(systemStateNr, ON_DFS1_STACK), newPropertyStateNr))
 	    {
 	      cycleSystemStateNr = systemStateNr;
 	      cyclePropertyStateNr = newPropertyStateNr;
 	      return true;
 	    }
-	  if (!(s.dfs2Seen.contains(newPropertyStateNr)))
+	  if (!contains(getField(systemStateNr, DFS2_SEEN), newPropertyStateNr))
 	    {
 	      if (dfs2SystemTransitions(systemStateNr, newPropertyStateNr))
 		{
@@ -150,13 +170,13 @@ ModelChecker2::dfs2PropertyTransitions(int systemStateNr, int propertyStateNr)
 bool
 ModelChecker2::dfs2SystemTransitions(int systemStateNr, int propertyStateNr)
 {
-  intersectionStates[systemStateNr].dfs2Seen.insert(propertyStateNr);
+  insert(getField(systemStateNr, DFS2_SEEN), propertyStateNr);
   for (int i = 0;; i++)
     {
       int n = system.getNextState(systemStateNr, i);
       if (n == NONE)
 	break;
-      Assert(n < intersectionStates.length(),
+      Assert((n + 1) * wordsPerState <= intersectionStates.length(),
 	     "visited system state for the first time on dfs2");
       if (dfs2PropertyTransitions(n, propertyStateNr))
 	return true;
@@ -167,8 +187,12 @@ ModelChecker2::dfs2SystemTransitions(int systemStateNr, int propertyStateNr)
 bool
 ModelChecker2::satisfiesPropositionalFormula(int systemStateNr, Bdd formula)
 {
-  NatSet& testedProps = intersectionStates[systemStateNr].testedProps;
-  NatSet& trueProps = intersectionStates[systemStateNr].trueProps;
+  //
+  //	No need to worry about these pointers being invalidated since
+  //	intersectionStates doesn't grow while we're here.
+  //
+  Word* testedProps = getField(systemStateNr, TESTED_PROPS);
+  Word* trueProps = getField(systemStateNr, TRUE_PROPS);
   for(;;)
     {
       if (formula == bdd_true())
@@ -176,14 +200,14 @@ ModelChecker2::satisfiesPropositionalFormula(int systemStateNr, Bdd formula)
       if (formula == bdd_false())
 	return false;
       int propIndex = bdd_var(formula);
-      if (testedProps.contains(propIndex))
-	formula = trueProps.contains(propIndex) ? bdd_high(formula) : bdd_low(formula);
+      if (contains(testedProps, propIndex))
+	formula = contains(trueProps, propIndex) ? bdd_high(formula) : bdd_low(formula);
       else
 	{
-	  testedProps.insert(propIndex);
+	  insert(testedProps, propIndex);
 	  if (system.checkProposition(systemStateNr, propIndex))
 	    {
-	      trueProps.insert(propIndex);
+	      insert(trueProps, propIndex);
 	      formula = bdd_high(formula);
 	    }
 	  else
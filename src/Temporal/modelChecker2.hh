@@ -51,13 +51,25 @@ public:
   const list<int>& getCycle() const;
 
 private:
-  struct StateSet
+  typedef unsigned long Word;
+
+  enum Constants
+  {
+    BITS_PER_WORD = BITS_PER_BYTE * sizeof(Word)
+  };
+  //
+  //	Each system state gets a fixed size run of words in intersectionStates,
+  //	divided into fields; the first three fields have a bit for each
+  //	property state and the last two have a bit for each proposition.
+  //
+  enum Field
   {
-    NatSet dfs1Seen;
-    NatSet onDfs1Stack;
-    NatSet dfs2Seen;
-    NatSet testedProps;
-    NatSet trueProps;
+    DFS1_SEEN,
+    ON_DFS1_STACK,
+    DFS2_SEEN,
+    TESTED_PROPS,
+    TRUE_PROPS,
+    NR_FIELDS
   };
 
   bool dfs1PropertyTransitions(int systemStateNr, int propertyStateNr);
@@ -65,10 +77,17 @@ private:
   bool dfs1SystemTransitions(int systemStateNr, int propertyStateNr);
   bool dfs2SystemTransitions(int systemStateNr, int propertyStateNr);
   bool satisfiesPropositionalFormula(int systemStateNr, Bdd formula);
+  void ensureState(int systemStateNr);
+  Word* getField(int systemStateNr, Field field);
+  static bool contains(const Word* bits, int index);
+  static void insert(Word* bits, int index);
+  static void subtract(Word* bits, int index);
 
   System& system;
   BuchiAutomaton2 propertyAutomaton;
-  Vector<StateSet> intersectionStates;
+  int fieldStart[NR_FIELDS];
+  int wordsPerState;
+  Vector<Word> intersectionStates;
   //
   //	Stuff for recovering counterexample.
   //
@@ -78,6 +97,38 @@ private:
   list<int> cycle;
 };
 
+inline void
+ModelChecker2::ensureState(int systemStateNr)
+{
+  int needed = (systemStateNr + 1) * wordsPerState;
+  if (needed > intersectionStates.length())
+    intersectionStates.expandTo(needed);  // new words are zeroed
+}
+
+inline ModelChecker2::Word*
+ModelChecker2::getField(int systemStateNr, Field field)
+{
+  return &(intersectionStates[systemStateNr * wordsPerState + fieldStart[field]]);
+}
+
+inline bool
+ModelChecker2::contains(const Word* bits, int index)
+{
+  return (bits[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1;
+}
+
+inline void
+ModelChecker2::insert(Word* bits, int index)
+{
+  bits[index / BITS_PER_WORD] |= static_cast<Word>(1) << (index % BITS_PER_WORD);
+}
+
+inline void
+ModelChecker2::subtract(Word* bits, int index)
+{
+  bits[index / BITS_PER_WORD] &= ~(static_cast<Word>(1) << (index % BITS_PER_WORD));
+}
+
 inline const list<int>&
 ModelChecker2::getLeadIn() const
 {
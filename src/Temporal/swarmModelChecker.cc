@@ -0,0 +1,395 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+
+//
+//      Implementation for class SwarmModelChecker.
+//
+#include <signal.h>
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+//      utility stuff
+#include "macros.hh"
+#include "vector.hh"
+
+//      forward declarations
+#include "temporal.hh"
+
+//      utility class definitions
+#include "swarmModelChecker.hh"
+
+class SwarmModelChecker::PermutedSystem : public ModelChecker2::System
+{
+public:
+  PermutedSystem(ModelChecker2::System& system, int workerNr);
+
+  int getNextState(int stateNr, int transitionNr);
+  bool checkProposition(int stateNr, int propositionIndex) const;
+
+private:
+  static Uint64 mix(Uint64 x);
+
+  ModelChecker2::System& system;
+  const int workerNr;
+  Vector<Vector<int> > successors;	// empty if not yet computed
+};
+
+SwarmModelChecker::PermutedSystem::PermutedSystem(ModelChecker2::System& system, int workerNr)
+  : system(system),
+    workerNr(workerNr)
+{
+}
+
+Uint64
+SwarmModelChecker::PermutedSystem::mix(Uint64 x)
+{
+  //
+  //	splitmix64 finalizer.
+  //
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+int
+SwarmModelChecker::PermutedSystem::getNextState(int stateNr, int transitionNr)
+{
+  if (stateNr >= successors.length())
+    successors.resize(stateNr + 1);
+  Vector<int>& s = successors[stateNr];
+  if (s.empty())
+    {
+      //
+      //	Our system always has at least one transition from each state
+      //	(deadlocked states get a self loop) so an empty vector means
+      //	we haven't computed the successors yet.
+      //
+      for (int i = 0;; ++i)
+	{
+	  int n = system.getNextState(stateNr, i);
+	  if (n == NONE)
+	    break;
+	  s.append(n);
+	}
+      //
+      //	Fisher-Yates shuffle, seeded by worker and state numbers so
+      //	that each worker has its own but reproducible order.
+      //
+      Uint64 seed = (static_cast<Uint64>(workerNr) << 32) | stateNr;
+      for (int i = s.length() - 1; i > 0; --i)
+	{
+	  seed = mix(seed);
+	  int j = seed % (i + 1);
+	  swap(s[i], s[j]);
+	}
+    }
+  return (transitionNr < s.length()) ? s[transitionNr] : NONE;
+}
+
+bool
+SwarmModelChecker::PermutedSystem::checkProposition(int stateNr, int propositionIndex) const
+{
+  return system.checkProposition(stateNr, propositionIndex);
+}
+
+template<class T>
+inline void
+appendBytes(string& buffer, const T& data)
+{
+  buffer.append(reinterpret_cast<const char*>(&data), sizeof(T));
+}
+
+SwarmModelChecker::SwarmModelChecker(System& system,
+				     LogicFormula& property,
+				     int top,
+				     int nrWorkers)
+  : system(system),
+    property(property),
+    top(top),
+    nrWorkers(nrWorkers)
+{
+}
+
+bool
+SwarmModelChecker::findCounterexample()
+{
+  bool found;
+  if (runWorkers(found))
+    return found;
+  //
+  //	Couldn't create workers, they all failed, or we were interrupted.
+  //
+  return checkSequentially();
+}
+
+bool
+SwarmModelChecker::checkSequentially()
+{
+  path.clear();
+  cycle.clear();
+  ModelChecker2 mc(system, property, top);
+  bool found = mc.findCounterexample();
+  path = mc.getLeadIn();
+  cycle = mc.getCycle();
+  return found;
+}
+
+bool
+SwarmModelChecker::runWorkers(bool& found)
+{
+  //
+  //	Make sure nothing buffered gets output more than once.
+  //
+  cout.flush();
+  cerr.flush();
+
+  Vector<pid_t> pids;
+  Vector<pollfd> ufds;
+  bool ok = true;
+  for (int i = 0; i < nrWorkers; ++i)
+    {
+      int pipeFds[2];
+      if (pipe(pipeFds) == -1)
+	{
+	  ok = false;
+	  break;
+	}
+      pid_t pid = fork();
+      if (pid == -1)
+	{
+	  close(pipeFds[0]);
+	  close(pipeFds[1]);
+	  ok = false;
+	  break;
+	}
+      if (pid == 0)
+	{
+	  for (const pollfd& u : ufds)
+	    close(u.fd);
+	  close(pipeFds[0]);
+	  runWorker(i, pipeFds[1]);
+	}
+      close(pipeFds[1]);
+      pids.append(pid);
+      pollfd u;
+      u.fd = pipeFds[0];
+      u.events = POLLIN;
+      ufds.append(u);
+    }
+  //
+  //	Wait for the first worker that produces a well formed answer; a
+  //	worker that dies without one (e.g. out of memory) is ignored.
+  //
+  bool decided = false;
+  int nrOpen = ufds.length();
+  while (ok && nrOpen > 0 && !decided)
+    {
+      if (poll(&ufds[0], ufds.length(), -1) == -1)
+	{
+	  if (errno == EINTR && !system.interrupted())
+	    continue;
+	  break;
+	}
+      for (pollfd& u : ufds)
+	{
+	  if (u.fd == -1 || u.revents == 0)
+	    continue;
+	  //
+	  //	A worker writes its answer in one go just before exiting,
+	  //	so we can read to end of file.
+	  //
+	  string result;
+	  char buffer[4096];
+	  for (;;)
+	    {
+	      ssize_t n = read(u.fd, buffer, sizeof(buffer));
+	      if (n > 0)
+		result.append(buffer, n);
+	      else if (n == 0 || errno != EINTR)
+		break;
+	    }
+	  close(u.fd);
+	  u.fd = -1;  // ignored by poll()
+	  --nrOpen;
+	  if (decodeResult(result, found))
+	    {
+	      decided = true;
+	      break;
+	    }
+	}
+    }
+  //
+  //	Everyone else is still working on an answer we no longer need.
+  //
+  for (pid_t pid : pids)
+    kill(pid, SIGKILL);
+  for (const pollfd& u : ufds)
+    {
+      if (u.fd != -1)
+	close(u.fd);
+    }
+  for (pid_t pid : pids)
+    {
+      while (waitpid(pid, 0, 0) == -1 && errno == EINTR)
+	;
+    }
+  return decided;
+}
+
+void
+SwarmModelChecker::runWorker(int workerNr, int fd)
+{
+  //
+  //	Interrupts are dealt with by our parent, which will kill us.
+  //
+  signal(SIGINT, SIG_IGN);
+  Vector<Int64> before;
+  system.getCounters(before);
+
+  PermutedSystem permutedSystem(system, workerNr);
+  ModelChecker2 mc(workerNr == 0 ? static_cast<ModelChecker2::System&>(system) :
+		   static_cast<ModelChecker2::System&>(permutedSystem),
+		   property,
+		   top);
+  bool found = mc.findCounterexample();
+
+  Vector<Int64> counters;
+  system.getCounters(counters);
+  int nrCounters = counters.length();
+  string buffer;
+  buffer += found ? 'y' : 'n';
+  appendBytes(buffer, nrCounters);
+  for (int i = 0; i < nrCounters; ++i)
+    appendBytes(buffer, counters[i] - before[i]);
+  if (found)
+    {
+      //
+      //	The lead-in starts at state 0, is followed by the cycle and we
+      //	finish back at the start of the cycle.
+      //
+      const list<int>& leadIn = mc.getLeadIn();
+      const list<int>& loop = mc.getCycle();
+      appendBytes(buffer, static_cast<int>(leadIn.size()));
+      appendBytes(buffer, static_cast<int>(loop.size()));
+      int from = NONE;
+      appendTransitions(buffer, leadIn, from);
+      appendTransitions(buffer, loop, from);
+      list<int> junction(1, loop.front());
+      appendTransitions(buffer, junction, from);
+    }
+
+  const char* p = buffer.data();
+  size_t nrBytes = buffer.size();
+  while (nrBytes > 0)
+    {
+      ssize_t n = write(fd, p, nrBytes);
+      if (n == -1)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  _exit(EXIT_FAILURE);
+	}
+      p += n;
+      nrBytes -= n;
+    }
+  close(fd);
+  _exit(EXIT_SUCCESS);
+}
+
+void
+SwarmModelChecker::appendTransitions(string& buffer, const list<int>& states, int& from)
+{
+  //
+  //	Record each step as the number of the unpermuted transition that
+  //	takes us there, since this is independent of state numbering.
+  //
+  for (int to : states)
+    {
+      if (from == NONE)
+	Assert(to == 0, "path doesn't start at initial state");
+      else
+	{
+	  int i = 0;
+	  while (system.getNextState(from, i) != to)
+	    {
+	      Assert(system.getNextState(from, i) != NONE, "missing transition");
+	      ++i;
+	    }
+	  appendBytes(buffer, i);
+	}
+      from = to;
+    }
+}
+
+bool
+SwarmModelChecker::decodeResult(const string& result, bool& found)
+{
+  const char* p = result.data();
+  const char* e = p + result.size();
+  int nrCounters;
+  if (e - p < static_cast<ptrdiff_t>(1 + sizeof(nrCounters)))
+    return false;
+  found = (*p++ == 'y');
+  memcpy(&nrCounters, p, sizeof(nrCounters));
+  p += sizeof(nrCounters);
+  if (nrCounters < 0 || e - p < static_cast<ptrdiff_t>(nrCounters * sizeof(Int64)))
+    return false;
+  Vector<Int64> counters(nrCounters);
+  memcpy(&counters[0], p, nrCounters * sizeof(Int64));
+  p += nrCounters * sizeof(Int64);
+
+  int lengths[2] = {0, 0};
+  if (found)
+    {
+      if (e - p < static_cast<ptrdiff_t>(sizeof(lengths)))
+	return false;
+      memcpy(lengths, p, sizeof(lengths));
+      p += sizeof(lengths);
+      if (lengths[0] < 0 || lengths[1] < 1)
+	return false;
+    }
+  int nrTransitions = lengths[0] + lengths[1];
+  if (e - p != static_cast<ptrdiff_t>(nrTransitions * sizeof(int)))
+    return false;
+
+  system.addCounters(counters);
+  path.clear();
+  cycle.clear();
+  //
+  //	Replay the counterexample so that its states exist in our system.
+  //
+  int stateNr = 0;
+  for (int i = 0; i < nrTransitions; ++i)
+    {
+      (i < lengths[0] ? path : cycle).push_back(stateNr);
+      int transitionNr;
+      memcpy(&transitionNr, p, sizeof(transitionNr));
+      p += sizeof(transitionNr);
+      stateNr = system.getNextState(stateNr, transitionNr);
+      Assert(stateNr != NONE, "bad transition number");
+    }
+  return true;
+}
@@ -0,0 +1,97 @@
+/*
+
+    This file is part of the Maude 3 interpreter.
+
+    Copyright 2026 SRI International, Menlo Park, CA 94025, USA.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+
+//
+//	Class for LTL model checking using several worker processes.
+//
+//	We implement a simple form of swarm verification: each worker is a
+//	fork()ed copy of the current process that runs the double depth first
+//	search of ModelChecker2 on its own copy of the system, with the
+//	successors of each system state visited in a different pseudo-random
+//	order. Since each search is complete, the first worker to finish
+//	decides the answer. A counterexample is passed back as a sequence of
+//	transition numbers from the initial state and replayed on the system
+//	in the parent, so that the states on the lead-in and cycle exist
+//	there. Worker 0 uses the unpermuted order and so behaves exactly as
+//	the sequential model checker would.
+//
+#ifndef _swarmModelChecker_hh_
+#define _swarmModelChecker_hh_
+#include <list>
+#include "modelChecker2.hh"
+
+class SwarmModelChecker
+{
+  NO_COPYING(SwarmModelChecker);
+
+public:
+  struct System : public ModelChecker2::System
+  {
+    //
+    //	Counters (such as rewrite counts) describing the work done so
+    //	far; the winning worker's increase is added in by the parent.
+    //
+    virtual void getCounters(Vector<Int64>& counters) const = 0;
+    virtual void addCounters(const Vector<Int64>& counters) = 0;
+    //
+    //	Polled when the parent is interrupted while waiting for workers;
+    //	true means give up on the workers and check sequentially.
+    //
+    virtual bool interrupted() const = 0;
+  };
+
+  SwarmModelChecker(System& system, LogicFormula& property, int top, int nrWorkers);
+  bool findCounterexample();
+  const list<int>& getLeadIn() const;
+  const list<int>& getCycle() const;
+
+private:
+  class PermutedSystem;
+
+  bool runWorkers(bool& found);
+  void runWorker(int workerNr, int fd);
+  bool decodeResult(const string& result, bool& found);
+  bool checkSequentially();
+  void appendTransitions(string& buffer, const list<int>& states, int& from);
+
+  System& system;
+  LogicFormula& property;
+  const int top;
+  const int nrWorkers;
+  list<int> path;
+  list<int> cycle;
+};
+
+inline const list<int>&
+SwarmModelChecker::getLeadIn() const
+{
+  return path;
+}
+
+inline const list<int>&
+SwarmModelChecker::getCycle() const
+{
+  return cycle;
+}
+
+#endif
@@ -33,5 +33,6 @@ class VeryWeakAlternatingAutomaton;
 class GenBuchiAutomaton;
 class BuchiAutomaton2;
 class ModelChecker2;
+class SwarmModelChecker;
 
 #endif
@@ -81,16 +81,51 @@ IntSystem::initializeUpperBounds()
 }
 
 bool
-IntSystem::greaterEqual(const IntVec& arg1, const IntVec& arg2)
+IntSystem::greaterEqual(IntVec::const_iterator arg1,
+			IntVec::const_iterator arg2,
+			int nrVariables)
 {
-  IntVec::const_iterator j = arg2.begin();
-  for (int i : arg1)
+  //
+  //	No early exit so that the compiler can vectorize the loop; vectors
+  //	that get this far have usually passed the pruning tests anyway.
+  //
+  int less = 0;
+  for (int i = 0; i < nrVariables; ++i)
+    less |= (arg1[i] < arg2[i]);
+  return less == 0;
+}
+
+Uint64
+IntSystem::support(const IntVec& arg)
+{
+  Uint64 mask = 0;
+  int nrVariables = arg.size();
+  for (int i = 0; i < nrVariables; ++i)
     {
-      if (i < *j)
-	return false;
-      ++j;
+      if (arg[i] != 0)
+	mask |= static_cast<Uint64>(1) << (i & 63);
     }
-  return true;
+  return mask;
+}
+
+int
+IntSystem::sum(const IntVec& arg)
+{
+  int total = 0;
+  for (int i : arg)
+    total += i;
+  return total;
+}
+
+void
+IntSystem::insertSolution(const IntVec& solution)
+{
+  int nrComponents = solutionComponents.size();
+  solutionComponents.expandBy(nrVariables);
+  for (int i = 0; i < nrVariables; ++i)
+    solutionComponents[nrComponents + i] = solution[i];
+  solutionSupports.append(support(solution));
+  solutionSums.append(sum(solution));
 }
 
 bool
@@ -99,9 +134,16 @@ IntSystem::minimal(const IntVec& arg)
   //
   //	A vector is minimal if it is not greater or equal to an existing solution.
   //
-  for (const IntVec& v : solutions)
+  Uint64 argSupport = support(arg);
+  int argSum = sum(arg);
+  IntVec::const_iterator a = arg.begin();
+  IntVec::const_iterator v = solutionComponents.begin();
+  int nrSolutions = solutionSums.size();
+  for (int i = 0; i < nrSolutions; ++i, v += nrVariables)
     {
-      if (greaterEqual(arg, v))
+      if ((solutionSupports[i] & ~argSupport) == 0 &&
+	  solutionSums[i] <= argSum &&
+	  greaterEqual(a, v, nrVariables))
 	return false;
     }
   return true;
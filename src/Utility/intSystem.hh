@@ -48,7 +48,12 @@ private:
   //
   typedef list<IntVec> VecList;
 
-  static bool greaterEqual(const IntVec& arg1, const IntVec& arg2);
+  static bool greaterEqual(IntVec::const_iterator arg1,
+			   IntVec::const_iterator arg2,
+			   int nrVariables);
+  static Uint64 support(const IntVec& arg);
+  static int sum(const IntVec& arg);
+  void insertSolution(const IntVec& solution);
   bool minimal(const IntVec& arg);
   void initializeUpperBounds();
 #ifndef NO_ASSERT
@@ -58,7 +63,16 @@ private:
   const int nrVariables;
   VecList eqns;			// Diophantine system
   IntVec upperBounds;		// upper bounds for each variable
-  VecList solutions;		// minimal solutions found so far
+  //
+  //	Minimal solutions found so far are stored contiguously, nrVariables
+  //	components at a time, to make the minimality check fast. A solution
+  //	can only be less or equal to a vector if its support (nonzero
+  //	components, with variables taken modulo 64) and its sum are too,
+  //	so we keep these alongside to prune the check.
+  //
+  Vector<int> solutionComponents;
+  Vector<Uint64> solutionSupports;
+  Vector<int> solutionSums;
   //
   //	Contejean-Devie specific stuff.
   //
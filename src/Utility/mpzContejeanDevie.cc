@@ -108,7 +108,7 @@ MpzSystem::findNextMinimalSolution(IntVec& solution)
       State& s = states[stackPointer];
       if (isZero(s.residue))
 	{
-	  solutions.push_back(s.assignment);
+	  insertSolution(s.assignment);
 	  solution = s.assignment;
 	  return true;
 	}
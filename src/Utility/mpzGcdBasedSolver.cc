@@ -396,7 +396,7 @@ MpzSystem::solveDiagonal()
 	cout << j << '\t';
       cout << endl;
 #endif
-      solutions.push_back(solution);
+      insertSolution(solution);
 
       if (allZero)
 	{
@@ -82,16 +82,41 @@ MpzSystem::greaterEqual(const IntVec& arg1, const IntVec& arg2)
   return true;
 }
 
+Uint64
+MpzSystem::support(const IntVec& arg)
+{
+  Uint64 mask = 0;
+  int nrVariables = arg.size();
+  for (int i = 0; i < nrVariables; ++i)
+    {
+      if (sgn(arg[i]) != 0)
+	mask |= static_cast<Uint64>(1) << (i & 63);
+    }
+  return mask;
+}
+
+void
+MpzSystem::insertSolution(const IntVec& solution)
+{
+  solutions.push_back(solution);
+  solutionSupports.append(support(solution));
+}
+
 bool
 MpzSystem::minimal(const IntVec& arg)
 {
   //
   //	A vector is minimal if it is not greater or equal to an existing solution.
+  //	A solution whose support isn't contained in that of arg can't be, and
+  //	is skipped without comparing bignums.
   //
+  Uint64 argSupport = support(arg);
+  Vector<Uint64>::const_iterator s = solutionSupports.begin();
   for (const IntVec& v : solutions)
     {
-      if (greaterEqual(arg, v))
+      if ((*s & ~argSupport) == 0 && greaterEqual(arg, v))
 	return false;
+      ++s;
     }
   return true;
 }
@@ -48,6 +48,8 @@ private:
   typedef list<IntVec> VecList;
 
   static bool greaterEqual(const IntVec& arg1, const IntVec& arg2);
+  static Uint64 support(const IntVec& arg);
+  void insertSolution(const IntVec& solution);
   bool minimal(const IntVec& arg);
   void initializeUpperBounds();
 #ifndef NO_ASSERT
@@ -58,6 +60,7 @@ private:
   VecList eqns;			// Diophantine system
   IntVec upperBounds;		// upper bounds for each variable, NONE means unbounded
   VecList solutions;		// minimal solutions found so far
+  Vector<Uint64> solutionSupports;	// nonzero components of each, modulo 64
   //
   //	Contejean-Devie specific stuff.
   //